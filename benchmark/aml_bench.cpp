@@ -0,0 +1,358 @@
+/*******************************************************************************
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *******************************************************************************/
+
+#include <map>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "Representation.h"
+#include "AMLInterface.h"
+#include "AMLException.h"
+#include "AMLGenerator.h"
+
+using namespace std;
+using namespace AML;
+
+/*
+    Microbenchmarks of Representation conversions and AMLData/AMLObject operations,
+    with the model of the sample app and with models generated by AMLGenerator.
+
+    Generated models have a SystemUnitClass "Unit0" of the width, the nesting depth and the list length,
+    and the AMLObject has its AMLData with random values.
+
+    Raw Data (name : "Unit0")
+    {
+        "s0": "<value>",
+        ...
+        "s<width - 1>": "<value>",
+        "nested0": {
+            "v": "<value>",
+            "n": {
+                ...
+                    "n": {
+                        "v": "<value>"
+                    }
+            }
+        },
+        "list0": [
+            "<value>",
+            ...
+        ]
+    }
+*/
+
+static const char SAMPLE_MODEL_FILE[] = "sample_data_model.aml";
+static const char GENERATED_MODEL_FILE[] = "aml_bench_model.aml";
+
+// sum of the sizes of results, so that conversions are not optimized out
+volatile size_t g_size = 0;
+
+static const char GENERATED_DATA_NAME[] = "Unit0";
+
+static AMLGeneratorConfig generatorConfig(int width, int depth, int listLength)
+{
+    AMLGeneratorConfig config;
+    config.systemUnitClassCount = 1;
+    config.attributeCount = width;
+    config.nestedAttributeCount = 1;
+    config.nestingDepth = depth;
+    config.orderedListCount = 1;
+    config.listLength = listLength;
+    return config;
+}
+
+static AMLObject sampleObject()
+{
+    AMLObject amlObj("SAMPLE001", "123456789");
+
+    AMLData model;
+    model.setValue("a", "Model_107.113.97.248");
+    model.setValue("b", "SR-P7-970");
+
+    AMLData axis;
+    axis.setValue("x", "20");
+    axis.setValue("y", "110");
+    axis.setValue("z", "80");
+
+    AMLData info;
+    info.setValue("id", "f437da3b");
+    info.setValue("axis", axis);
+
+    AMLData sample;
+    sample.setValue("info", info);
+    sample.setValue("appendix", vector<string>{"935", "52303", "1442"});
+
+    amlObj.addData("Model", model);
+    amlObj.addData("Sample", sample);
+
+    return amlObj;
+}
+
+// Representation with an AMLObject of its model and the AMLObject converted, which are prepared once for each model.
+struct Input
+{
+    Input(const string& modelFile, const AMLObject& object)
+     : rep(modelFile), amlObj(object), xml(rep.DataToAml(amlObj))
+    {
+#ifndef _DISABLE_PROTOBUF_
+        binary = rep.DataToByte(amlObj);
+#endif
+    }
+
+    Representation rep;
+    AMLObject amlObj;
+    string xml;
+    string binary;
+};
+
+static Input& sampleInput(const benchmark::State&)
+{
+    static Input input(SAMPLE_MODEL_FILE, sampleObject());
+    return input;
+}
+
+// arguments of the state are width, depth and list length
+static Input& generatedInput(const benchmark::State& state)
+{
+    static map<tuple<int, int, int>, unique_ptr<Input>> inputs;
+
+    int width = static_cast<int>(state.range(0));
+    int depth = static_cast<int>(state.range(1));
+    int listLength = static_cast<int>(state.range(2));
+
+    unique_ptr<Input>& input = inputs[make_tuple(width, depth, listLength)];
+    if (!input)
+    {
+        AMLGenerator generator(generatorConfig(width, depth, listLength));
+        generator.writeModel(GENERATED_MODEL_FILE);
+        input.reset(new Input(GENERATED_MODEL_FILE, generator.event()));
+    }
+    return *input;
+}
+
+// Each of width, depth and list length is changed from the base, so that the scaling of each is shown.
+static void recordArgs(benchmark::internal::Benchmark* bench)
+{
+    const int width = 16, depth = 2, listLength = 8;
+
+    bench->ArgNames({"width", "depth", "list"});
+    for (int w : {4, 16, 64, 400})     bench->Args({w, depth, listLength});
+    for (int d : {1, 8, 32})            bench->Args({width, d, listLength});
+    for (int l : {1, 64, 512})          bench->Args({width, depth, l});
+}
+
+typedef Input& (*InputFunc)(const benchmark::State&);
+
+template <InputFunc getInput>
+static void BM_DataToAml(benchmark::State& state)
+{
+    Input& input = getInput(state);
+    string xml;
+    for (auto _ : state)
+    {
+        xml = input.rep.DataToAml(input.amlObj);
+        g_size += xml.size();
+    }
+    state.SetBytesProcessed(state.iterations() * input.xml.size());
+}
+
+template <InputFunc getInput>
+static void BM_AmlToData(benchmark::State& state)
+{
+    Input& input = getInput(state);
+    for (auto _ : state)
+    {
+        AMLObject* amlObj = input.rep.AmlToData(input.xml);
+        g_size += amlObj->getDataNames().size();
+        delete amlObj;
+    }
+    state.SetBytesProcessed(state.iterations() * input.xml.size());
+}
+
+#ifndef _DISABLE_PROTOBUF_
+template <InputFunc getInput>
+static void BM_DataToByte(benchmark::State& state)
+{
+    Input& input = getInput(state);
+    string binary;
+    for (auto _ : state)
+    {
+        binary = input.rep.DataToByte(input.amlObj);
+        g_size += binary.size();
+    }
+    state.SetBytesProcessed(state.iterations() * input.binary.size());
+}
+
+template <InputFunc getInput>
+static void BM_ByteToData(benchmark::State& state)
+{
+    Input& input = getInput(state);
+    for (auto _ : state)
+    {
+        AMLObject* amlObj = input.rep.ByteToData(input.binary);
+        g_size += amlObj->getDataNames().size();
+        delete amlObj;
+    }
+    state.SetBytesProcessed(state.iterations() * input.binary.size());
+}
+#endif // _DISABLE_PROTOBUF_
+
+template <InputFunc getInput>
+static void BM_GetConfigInfo(benchmark::State& state)
+{
+    Input& input = getInput(state);
+    for (auto _ : state)
+    {
+        AMLObject* config = input.rep.getConfigInfo();
+        g_size += config->getDataNames().size();
+        delete config;
+    }
+}
+
+static AMLData nestedData(const vector<string>& values, size_t level)
+{
+    AMLData data;
+    data.setValue("v", values[level]);
+    if (level + 1 < values.size())
+    {
+        data.setValue("n", nestedData(values, level + 1));
+    }
+    return data;
+}
+
+// sets the values of the generated AMLData of the width, depth and list length to a new AMLData
+static void BM_AMLData_setValue(benchmark::State& state)
+{
+    const AMLData& data = generatedInput(state).amlObj.getData(GENERATED_DATA_NAME);
+    int width = static_cast<int>(state.range(0));
+    int depth = static_cast<int>(state.range(1));
+
+    vector<pair<string, string>> values;
+    for (int i = 0; i < width; ++i)
+    {
+        string key = "s" + to_string(i);
+        values.push_back(make_pair(key, data.getValueToStr(key)));
+    }
+
+    vector<string> nestedValues;
+    const AMLData* nested = &data.getValueToAMLData("nested0");
+    for (int level = 1; level < depth; ++level)
+    {
+        nestedValues.push_back(nested->getValueToStr("v"));
+        nested = &nested->getValueToAMLData("n");
+    }
+    nestedValues.push_back(nested->getValueToStr("v"));
+
+    vector<string> list = data.getValueToStrArr("list0");
+
+    for (auto _ : state)
+    {
+        AMLData newData;
+        for (const pair<string, string>& value : values)
+        {
+            newData.setValue(value.first, value.second);
+        }
+
+        newData.setValue("nested0", nestedData(nestedValues, 0));
+
+        newData.setValue("list0", list);
+        g_size += newData.getKeys().size();
+    }
+}
+
+// gets all values of the generated AMLData with the getter of each type
+static void BM_AMLData_getValue(benchmark::State& state)
+{
+    const AMLData& data = generatedInput(state).amlObj.getData(GENERATED_DATA_NAME);
+    int width = static_cast<int>(state.range(0));
+    int depth = static_cast<int>(state.range(1));
+
+    vector<string> keys;
+    for (int i = 0; i < width; ++i)
+    {
+        keys.push_back("s" + to_string(i));
+    }
+
+    for (auto _ : state)
+    {
+        for (const string& key : keys)
+        {
+            g_size += data.getValueToStr(key).size();
+        }
+
+        const AMLData* nested = &data.getValueToAMLData("nested0");
+        for (int level = 1; level < depth; ++level)
+        {
+            g_size += nested->getValueToStr("v").size();
+            nested = &nested->getValueToAMLData("n");
+        }
+        g_size += nested->getValueToStr("v").size();
+
+        g_size += data.getValueToStrArr("list0").size();
+    }
+}
+
+// copies AMLObject, which shares the AMLData of the original
+template <InputFunc getInput>
+static void BM_AMLObject_copy(benchmark::State& state)
+{
+    const AMLObject& amlObj = getInput(state).amlObj;
+    for (auto _ : state)
+    {
+        AMLObject copyObj(amlObj);
+        g_size += copyObj.getDataNames().size();
+    }
+}
+
+// copies AMLObject and adds an AMLData to the copy, which does not change the original
+template <InputFunc getInput>
+static void BM_AMLObject_copyAndModify(benchmark::State& state)
+{
+    const AMLObject& amlObj = getInput(state).amlObj;
+    for (auto _ : state)
+    {
+        AMLObject copyObj(amlObj);
+        copyObj.emplaceData("Copy").setValue("key", "value");
+        g_size += copyObj.getDataNames().size();
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_DataToAml, sampleInput);
+BENCHMARK_TEMPLATE(BM_DataToAml, generatedInput)->Apply(recordArgs);
+BENCHMARK_TEMPLATE(BM_AmlToData, sampleInput);
+BENCHMARK_TEMPLATE(BM_AmlToData, generatedInput)->Apply(recordArgs);
+#ifndef _DISABLE_PROTOBUF_
+BENCHMARK_TEMPLATE(BM_DataToByte, sampleInput);
+BENCHMARK_TEMPLATE(BM_DataToByte, generatedInput)->Apply(recordArgs);
+BENCHMARK_TEMPLATE(BM_ByteToData, sampleInput);
+BENCHMARK_TEMPLATE(BM_ByteToData, generatedInput)->Apply(recordArgs);
+#endif // _DISABLE_PROTOBUF_
+BENCHMARK_TEMPLATE(BM_GetConfigInfo, sampleInput);
+BENCHMARK_TEMPLATE(BM_GetConfigInfo, generatedInput)->ArgNames({"width", "depth", "list"})->Args({16, 2, 8});
+BENCHMARK(BM_AMLData_setValue)->Apply(recordArgs);
+BENCHMARK(BM_AMLData_getValue)->Apply(recordArgs);
+BENCHMARK_TEMPLATE(BM_AMLObject_copy, sampleInput);
+BENCHMARK_TEMPLATE(BM_AMLObject_copy, generatedInput)->Apply(recordArgs);
+BENCHMARK_TEMPLATE(BM_AMLObject_copyAndModify, sampleInput);
+BENCHMARK_TEMPLATE(BM_AMLObject_copyAndModify, generatedInput)->Apply(recordArgs);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,101 @@
+/*******************************************************************************
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *******************************************************************************/
+
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "AMLInterface.h"
+#include "AMLException.h"
+
+using namespace std;
+using namespace AML;
+
+/*
+    Measures construction and lookup of AMLData with the given number of string values,
+    and the same operations with std::map<std::string, std::string> as a reference.
+*/
+
+// sum of the length of values looked up, so that lookups are not optimized out
+volatile size_t g_length = 0;
+
+template <typename F>
+static double measure(int iterations, F func)
+{
+    auto begin = chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i)
+    {
+        func();
+    }
+    auto end = chrono::steady_clock::now();
+
+    return chrono::duration<double, micro>(end - begin).count() / iterations;
+}
+
+int main(int argc, char* argv[])
+{
+    int iterations = (argc > 1) ? atoi(argv[1]) : 10000;
+    const int widths[] = {3, 10, 50, 400};
+
+    cout << "width\tAMLData build(us)\tAMLData lookup(us)\tstd::map build(us)\tstd::map lookup(us)" << endl;
+
+    try
+    {
+        for (int width : widths)
+        {
+            vector<string> keys;
+            for (int i = 0; i < width; ++i)
+            {
+                keys.push_back("signal_" + to_string((i * 7919) % width)); // not in order of key
+            }
+
+            AMLData amlData;
+            map<string, string> reference;
+            for (const string& key : keys)
+            {
+                amlData.setValue(key, key);
+                reference.insert(make_pair(key, key));
+            }
+
+            double amlDataBuild = measure(iterations, [&]() {
+                AMLData data;
+                for (const string& key : keys)  data.setValue(key, key);
+            });
+            double amlDataLookup = measure(iterations, [&]() {
+                for (const string& key : keys)  g_length += amlData.getValueToStr(key).size();
+            });
+            double mapBuild = measure(iterations, [&]() {
+                map<string, string> data;
+                for (const string& key : keys)  data.insert(make_pair(key, key));
+            });
+            double mapLookup = measure(iterations, [&]() {
+                for (const string& key : keys)  g_length += reference.find(key)->second.size();
+            });
+
+            cout << width << "\t" << amlDataBuild << "\t" << amlDataLookup << "\t" << mapBuild << "\t" << mapLookup << endl;
+        }
+    }
+    catch (const AMLException& e)
+    {
+        cout << "Exception : " << e.what() << endl;
+        return 1;
+    }
+
+    return 0;
+}
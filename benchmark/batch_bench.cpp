@@ -0,0 +1,144 @@
+/*******************************************************************************
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *******************************************************************************/
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "Representation.h"
+#include "AMLInterface.h"
+#include "AMLException.h"
+
+using namespace std;
+using namespace AML;
+
+/*
+    Measures the cost per AMLObject of batch conversions with the given batch sizes,
+    on the calling thread and on a pool of the given number of threads (0 for the number of cores),
+    and the same conversions of single AMLObjects as a reference.
+    The AMLObject is the one of the sample app, with a different id for each item.
+*/
+
+static const char MODEL_FILE[] = "sample_data_model.aml";
+
+static AMLObject sampleObject(int index)
+{
+    AMLObject amlObj("SAMPLE001", to_string(123456789 + index));
+
+    AMLData model;
+    model.setValue("a", "Model_107.113.97.248");
+    model.setValue("b", "SR-P7-970");
+
+    AMLData axis;
+    axis.setValue("x", "20");
+    axis.setValue("y", "110");
+    axis.setValue("z", "80");
+
+    AMLData info;
+    info.setValue("id", "f437da3b");
+    info.setValue("axis", axis);
+
+    AMLData sample;
+    sample.setValue("info", info);
+    sample.setValue("appendix", vector<string>{"935", "52303", "1442"});
+
+    amlObj.addData("Model", model);
+    amlObj.addData("Sample", sample);
+
+    return amlObj;
+}
+
+// returns the time per item of the batch
+template <typename F>
+static double measure(int iterations, size_t batchSize, F func)
+{
+    auto begin = chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i)
+    {
+        func();
+    }
+    auto end = chrono::steady_clock::now();
+
+    return chrono::duration<double, micro>(end - begin).count() / iterations / batchSize;
+}
+
+int main(int argc, char* argv[])
+{
+    int iterations = (argc > 1) ? atoi(argv[1]) : 100;
+    int threadCount = (argc > 2) ? atoi(argv[2]) : 0;
+    const size_t batchSizes[] = {1, 16, 256};
+
+    try
+    {
+        Representation rep(MODEL_FILE);
+        AMLWorkerPool pool(threadCount);
+        cout << "threads of pool : " << pool.threadCount() << endl;
+        cout << "batch\tAPI\tDataToAml(us)\tAmlToData(us)\tDataToByte(us)\tByteToData(us)" << endl;
+
+        for (size_t batchSize : batchSizes)
+        {
+            vector<AMLObject> amlObjs;
+            for (size_t i = 0; i < batchSize; ++i)
+            {
+                amlObjs.push_back(sampleObject(i));
+            }
+
+            vector<string> xmlStrs, binaries;
+            vector<AMLObject> decoded;
+            rep.DataToAml(amlObjs, xmlStrs);
+            rep.DataToByte(amlObjs, binaries);
+
+            double singleEncodeXml = measure(iterations, batchSize, [&]() {
+                for (const AMLObject& amlObj : amlObjs)     rep.DataToAml(amlObj);
+            });
+            double singleDecodeXml = measure(iterations, batchSize, [&]() {
+                for (const string& xmlStr : xmlStrs)        delete rep.AmlToData(xmlStr);
+            });
+            double singleEncodeByte = measure(iterations, batchSize, [&]() {
+                for (const AMLObject& amlObj : amlObjs)     rep.DataToByte(amlObj);
+            });
+            double singleDecodeByte = measure(iterations, batchSize, [&]() {
+                for (const string& binary : binaries)       delete rep.ByteToData(binary);
+            });
+
+            double batchEncodeXml = measure(iterations, batchSize, [&]() { rep.DataToAml(amlObjs, xmlStrs); });
+            double batchDecodeXml = measure(iterations, batchSize, [&]() { rep.AmlToData(xmlStrs, decoded); });
+            double batchEncodeByte = measure(iterations, batchSize, [&]() { rep.DataToByte(amlObjs, binaries); });
+            double batchDecodeByte = measure(iterations, batchSize, [&]() { rep.ByteToData(binaries, decoded); });
+
+            double parallelEncodeXml = measure(iterations, batchSize, [&]() { rep.DataToAml(amlObjs, xmlStrs, pool); });
+            double parallelDecodeXml = measure(iterations, batchSize, [&]() { rep.AmlToData(xmlStrs, decoded, pool); });
+            double parallelEncodeByte = measure(iterations, batchSize, [&]() { rep.DataToByte(amlObjs, binaries, pool); });
+            double parallelDecodeByte = measure(iterations, batchSize, [&]() { rep.ByteToData(binaries, decoded, pool); });
+
+            cout << batchSize << "\tsingle\t" << singleEncodeXml << "\t" << singleDecodeXml << "\t"
+                 << singleEncodeByte << "\t" << singleDecodeByte << endl;
+            cout << batchSize << "\tbatch\t" << batchEncodeXml << "\t" << batchDecodeXml << "\t"
+                 << batchEncodeByte << "\t" << batchDecodeByte << endl;
+            cout << batchSize << "\tparallel\t" << parallelEncodeXml << "\t" << parallelDecodeXml << "\t"
+                 << parallelEncodeByte << "\t" << parallelDecodeByte << endl;
+        }
+    }
+    catch (const AMLException& e)
+    {
+        cout << "Exception : " << e.what() << endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,145 @@
+/*******************************************************************************
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *******************************************************************************/
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "Representation.h"
+#include "AMLInterface.h"
+#include "AMLException.h"
+
+using namespace std;
+using namespace AML;
+
+/*
+    Measures DataToByte() and ByteToData() of AMLData nested to the given depth.
+
+    Raw Data (name : "Nested")
+    {
+        "v": "0",
+        "n": {
+            "v": "1",
+            "n": {
+                ...
+                    "n": {
+                        "v": "<depth>"
+                    }
+            }
+        }
+    }
+*/
+
+static const char MODEL_FILE[] = "nested_data_model.aml";
+
+// writes a model with SystemUnitClass "Nested" whose <Attribute>s are nested to the depth
+static void writeModel(const string& filePath, int depth)
+{
+    ostringstream xml;
+    xml << "<?xml version=\"1.0\" encoding=\"utf-8\"?>\n"
+        << "<CAEXFile FileName=\"\" SchemaVersion=\"2.15\">\n"
+        << "<RoleClassLib Name=\"BENCH\">\n"
+        << "<RoleClass Name=\"Nested\" />\n"
+        << "</RoleClassLib>\n"
+        << "<SystemUnitClassLib Name=\"BENCH_SUCL\">\n"
+        << "<Version>0.0.1</Version>\n"
+        << "<SystemUnitClass Name=\"Event\">\n"
+        << "<Attribute Name=\"device\" AttributeDataType=\"xs:string\" />\n"
+        << "<Attribute Name=\"timestamp\" AttributeDataType=\"xs:string\" />\n"
+        << "<Attribute Name=\"id\" AttributeDataType=\"xs:string\" />\n"
+        << "</SystemUnitClass>\n"
+        << "<SystemUnitClass Name=\"Nested\">\n";
+
+    for (int i = 0; i < depth; ++i)
+    {
+        xml << "<Attribute Name=\"v\" AttributeDataType=\"xs:string\" />\n"
+            << "<Attribute Name=\"n\" AttributeDataType=\"xs:string\">\n";
+    }
+    xml << "<Attribute Name=\"v\" AttributeDataType=\"xs:string\" />\n";
+    for (int i = 0; i < depth; ++i)
+    {
+        xml << "</Attribute>\n";
+    }
+
+    xml << "<SupportedRoleClass RefRoleClassPath=\"BENCH/Nested\" />\n"
+        << "</SystemUnitClass>\n"
+        << "</SystemUnitClassLib>\n"
+        << "</CAEXFile>\n";
+
+    ofstream file(filePath);
+    file << xml.str();
+}
+
+static AMLData nestedData(int level, int depth)
+{
+    AMLData data;
+    data.setValue("v", to_string(level));
+    if (level < depth)
+    {
+        data.setValue("n", nestedData(level + 1, depth));
+    }
+    return data;
+}
+
+template <typename F>
+static double measure(int iterations, F func)
+{
+    auto begin = chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i)
+    {
+        func();
+    }
+    auto end = chrono::steady_clock::now();
+
+    return chrono::duration<double, micro>(end - begin).count() / iterations;
+}
+
+int main(int argc, char* argv[])
+{
+    int maxDepth = (argc > 1) ? atoi(argv[1]) : 16;
+    int iterations = (argc > 2) ? atoi(argv[2]) : 1000;
+
+    cout << "depth\tDataToByte(us)\tByteToData(us)" << endl;
+
+    try
+    {
+        for (int depth = 1; depth <= maxDepth; depth *= 2)
+        {
+            writeModel(MODEL_FILE, depth);
+            Representation rep(MODEL_FILE);
+
+            AMLObject amlObj("BENCH001", "123456789");
+            amlObj.addData("Nested", nestedData(0, depth));
+
+            string binary = rep.DataToByte(amlObj);
+
+            double encode = measure(iterations, [&]() { rep.DataToByte(amlObj); });
+            double decode = measure(iterations, [&]() { delete rep.ByteToData(binary); });
+
+            cout << depth << "\t" << encode << "\t" << decode << endl;
+        }
+    }
+    catch (const AMLException& e)
+    {
+        cout << "Exception : " << e.what() << endl;
+        return 1;
+    }
+
+    return 0;
+}
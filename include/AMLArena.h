@@ -0,0 +1,118 @@
+/*******************************************************************************
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *******************************************************************************/
+
+#ifndef AML_ARENA_H_
+#define AML_ARENA_H_
+
+#include <cstddef>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace AML
+{
+
+/**
+ * @class AMLArena
+ * @brief This class allocates memory in large blocks and releases all of it at once by reset().
+ *        Representation decodes AMLObject into an arena, so that a decode loop does not allocate and free its values one by one.
+ *        An arena is not thread-safe, so each thread uses its own arena.
+ */
+class AMLArena
+{
+public:
+    /**
+     * @brief       Constructor.
+     * @param       blockSize   [in] Size of memory block in bytes. Larger allocation uses a block of its own.
+     */
+    explicit AMLArena(size_t blockSize = 16 * 1024);
+
+    /**
+     * @brief       Destructor. Objects constructed in the arena are destroyed as reset() does.
+     */
+    virtual ~AMLArena(void);
+
+    /**
+     * @fn void* allocate(size_t size, size_t alignment)
+     * @brief       This function allocates memory in the arena, which is valid until reset().
+     * @param       size        [in] Size in bytes.
+     * @param       alignment   [in] Alignment in bytes, which is a power of 2 not greater than alignof(std::max_align_t).
+     * @return      Allocated memory.
+     */
+    void*                           allocate(size_t size, size_t alignment);
+
+    /**
+     * @fn T* construct(Args&&... args)
+     * @brief       This function constructs an object in the arena, which is destroyed by reset().
+     * @param       args    [in] Arguments of the constructor of T.
+     * @return      Constructed object, which should not be deleted.
+     */
+    template <typename T, typename... Args>
+    T*                              construct(Args&&... args)
+    {
+        T* object = new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+        try
+        {
+            m_objects.push_back(std::make_pair(static_cast<void*>(object), &destroy<T>));
+        }
+        catch (...)
+        {
+            object->~T();
+            throw;
+        }
+        return object;
+    }
+
+    /**
+     * @fn void reset()
+     * @brief       This function destroys the objects constructed in the arena, in reverse order,
+     *              and releases all memory allocated in the arena, keeping the first block to be reused.
+     * @note        AMLObject and AMLData in the arena can not be used after reset(). Copies of them and the ones moved out of them are not in the arena.
+     */
+    void                            reset();
+
+    /**
+     * @fn size_t size() const
+     * @brief       This function returns the size of memory allocated since the last reset().
+     * @return      Size in bytes.
+     */
+    size_t                          size() const;
+
+private:
+    AMLArena(const AMLArena&) = delete;
+    AMLArena& operator=(const AMLArena&) = delete;
+
+    template <typename T>
+    static void                     destroy(void* object)
+    {
+        static_cast<T*>(object)->~T();
+    }
+
+    char*                           allocateBlock(size_t size);
+
+    size_t                          m_blockSize;
+    char*                           m_firstBlock;   // kept by reset()
+    std::vector<char*>              m_blocks;       // blocks allocated after m_firstBlock
+    std::vector<std::pair<void*, void (*)(void*)>> m_objects;  // objects constructed by construct()
+    char*                           m_pos;
+    char*                           m_end;
+    size_t                          m_size;
+};
+
+} // namespace AML
+
+#endif // AML_ARENA_H_
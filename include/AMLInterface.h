@@ -20,12 +20,17 @@
 
 #include <string>
 #include <vector>
-#include <map>
+#include <utility>
+#include <memory>
 
 namespace AML
 {
 
 class AMLData;
+class AMLValue; // defined in internal/AMLValue.h
+class AMLKeyTable; // defined in internal/AMLKeyTable.h
+class AMLArena;
+class Representation;
 
 /**
  * @class AMLValueType
@@ -38,31 +43,10 @@ enum class AMLValueType
     AMLData
 };
 
-/**
- * @class AMLValue
- * @brief This class use for AMLValue interface.
- */
-class AMLValue
-{
-public:
-    AMLValue(AMLValueType t) : m_type(t)
-    {
-    }
-    virtual ~AMLValue()
-    {
-    }
-
-    AMLValueType getType()
-    {
-        return m_type;
-    }
-private:
-    AMLValueType m_type;
-};
-
 /**
  * @class AMLObject
  * @brief This class have AMLData.
+ *        Copies share AMLData until one of them is modified, so that copy is cheap and a shared AMLObject can be read from multiple threads.
  * @see AMLData
  */
 class AMLObject
@@ -83,6 +67,16 @@ public:
      */
     AMLObject(const std::string& deviceId, const std::string& timeStamp, const std::string& id);
 
+    /**
+     * @brief       Constructor with an arena, which is used by Representation.
+     * @param       deviceId    [in] Device id that source device of AMLObject.
+     * @param       timestamp   [in] timestamp value of AMLObject delibered by device.
+     * @param       id          [in] id of AMLObject.
+     * @param       arena       [in] Arena where AMLData are allocated, or null to allocate them on the heap.
+     *                               Copies and moves of AMLObject in an arena are allocated on the heap.
+     */
+    AMLObject(const std::string& deviceId, const std::string& timeStamp, const std::string& id, AMLArena* arena);
+
     /**
      * @brief       Copy Constructor Overloading.
      */
@@ -93,6 +87,19 @@ public:
      */
     AMLObject& operator=(const AMLObject& t);
 
+    /**
+     * @brief       Move Constructor Overloading.
+     *              AMLData of t in an arena are copied to the heap as the copy constructor does, so that the moved AMLObject outlives the arena.
+     */
+    AMLObject(AMLObject&& t) noexcept;
+
+    /**
+     * @brief       Move Assignment Operator Overloading.
+     *              AMLData of t are moved as addData() does, so that AMLException is thrown if a name is duplicated.
+     *              AMLData of t in an arena are copied to the heap as the move constructor does.
+     */
+    AMLObject& operator=(AMLObject&& t);
+
     virtual ~AMLObject(void);
 
     /**
@@ -104,6 +111,35 @@ public:
      */
     void                            addData(const std::string& name, const AMLData& data);
 
+    /**
+     * @fn void addData(const std::string& name, AMLData&& data)
+     * @brief       This function add AMLData to AMLObject, moving the content of data without copy.
+     * @param       name    [in] AMLData key.
+     * @param       data    [in] AMLData value. It is left empty.
+     * @exception   AMLException If AMLData key is duplicated on AMLObject or if name is a invalid key.
+     */
+    void                            addData(const std::string& name, AMLData&& data);
+
+    /**
+     * @fn AMLData& emplaceData(const std::string& name)
+     * @brief       This function add an empty AMLData to AMLObject and return it to be filled in place.
+     * @param       name    [in] AMLData key.
+     * @return      Added AMLData, which is valid until AMLObject is copied, reset or destroyed.
+     * @exception   AMLException If AMLData key is duplicated on AMLObject or if name is a invalid key.
+     */
+    AMLData&                        emplaceData(const std::string& name);
+
+    /**
+     * @fn void reset(const std::string& deviceId, const std::string& timeStamp, const std::string& id)
+     * @brief       This function sets ids and removes all AMLData, so that AMLObject is reused for another event.
+     *              Storage of the removed AMLData is kept and reused by emplaceData() in the same order.
+     * @param       deviceId    [in] Device id that source device of AMLObject.
+     * @param       timestamp   [in] timestamp value of AMLObject delibered by device.
+     * @param       id          [in] id of AMLObject.
+     * @exception   AMLException If any of parameters is empty.
+     */
+    void                            reset(const std::string& deviceId, const std::string& timeStamp, const std::string& id);
+
     /**
      * @fn AMLData getData(const std::string& name) const
      * @brief       This function return AMLData which matched input name string with AMLObject's amlDatas key.
@@ -142,6 +178,18 @@ public:
     const std::string&              getId() const;
 
 private:
+    friend class Representation;    // decodes AMLData with the key table of its model
+
+    /**
+     * @fn AMLData& emplaceData(const std::string& name, const std::shared_ptr<const AMLKeyTable>& keyTable)
+     * @brief       This function add an empty AMLData with interned keys of a model, which is used by Representation.
+     * @param       name        [in] AMLData key.
+     * @param       keyTable    [in] Key table of a model, which is used unless AMLData removed by reset() is reused.
+     * @return      Added AMLData, which is valid until AMLObject is copied, reset or destroyed.
+     * @exception   AMLException If AMLData key is duplicated on AMLObject or if name is a invalid key.
+     */
+    AMLData&                        emplaceData(const std::string& name, const std::shared_ptr<const AMLKeyTable>& keyTable);
+
     /**
      * @fn void copyData(AMLObject* target) const
      * @brief       This function copy AMLData Data 
@@ -149,15 +197,25 @@ private:
      */
     void                            copyObject(AMLObject* target) const;
 
-    const std::string m_deviceId;
-    const std::string m_timeStamp;
-    const std::string m_id;
-    mutable std::map<std::string, AMLData*> m_amlDatas;
+    struct AMLDataList;
+
+    AMLDataList&                    mutableDatas();
+    void                            verifyNewName(const std::string& name) const;
+    template <typename T>
+    AMLData&                        insertData(const std::string& name, T&& data);
+
+    std::string m_deviceId;
+    std::string m_timeStamp;
+    std::string m_id;
+    std::shared_ptr<AMLDataList> m_amlDatas;    // sorted by name, shared by copies until one of them is modified
+    AMLArena* m_arena;                          // arena where m_amlDatas is allocated, or null
 };
 
 /**
  * @class AMLData
  * @brief This class have RawData map which have key value pair.
+ *        Pairs are kept in a vector with an index sorted by key, so references returned by getters are valid until setValue() or assignment.
+ *        Copies share the pairs until one of them is modified, so that copy is cheap and a shared AMLData can be read from multiple threads.
  */
 class AMLData
 {
@@ -174,6 +232,19 @@ public:
      */
     AMLData& operator=(const AMLData& t);
 
+    /**
+     * @brief       Move Constructor Overloading.
+     *              Values of t in an arena are copied to the heap as the copy constructor does, so that the moved AMLData outlives the arena.
+     */
+    AMLData(AMLData&& t) noexcept;
+
+    /**
+     * @brief       Move Assignment Operator Overloading.
+     *              Values of t are moved as setValue() does, so that AMLException is thrown if a key is duplicated.
+     *              Values of t in an arena are copied to the heap as the move constructor does.
+     */
+    AMLData& operator=(AMLData&& t);
+
     virtual ~AMLData(void);
 
     /**
@@ -200,6 +271,46 @@ public:
      */
     void                            setValue(const std::string& key, const AMLData& value);
 
+    /**
+     * @fn void setValue(const std::string& key, std::string&& value)
+     * @brief       This function set key and string type value pair on AMLData, moving value without copy.
+     * @param       key     [in] AMLData key.
+     * @param       value   [in] AMLData value.
+     */
+    void                            setValue(const std::string& key, std::string&& value);
+
+    /**
+     * @fn void setValue(const std::string& key, std::vector<std::string>&& value)
+     * @brief       This function set key and string vector type value pair on AMLData, moving value without copy.
+     * @param       key     [in] AMLData key.
+     * @param       value   [in] AMLData value.
+     */
+    void                            setValue(const std::string& key, std::vector<std::string>&& value);
+
+    /**
+     * @fn void setValue(const std::string& key, AMLData&& value)
+     * @brief       This function set key and AMLData type value pair on AMLData, moving value without copy.
+     * @param       key     [in] AMLData key
+     * @param       value   [in] AMLData value
+     */
+    void                            setValue(const std::string& key, AMLData&& value);
+
+    /**
+     * @fn AMLData& emplaceData(const std::string& key)
+     * @brief       This function set key and an empty AMLData pair on AMLData and return the AMLData to be filled in place.
+     * @param       key     [in] AMLData key
+     * @return      Added AMLData, which is valid until setValue(), copy or assignment of this AMLData.
+     */
+    AMLData&                        emplaceData(const std::string& key);
+
+    /**
+     * @fn void clear()
+     * @brief       This function removes all values, so that AMLData is reused.
+     *              Storage of the removed values is kept and reused by setValue() and emplaceData() in the same order,
+     *              for values of the same type.
+     */
+    void                            clear();
+
     /**
      * @fn std::string getValueToStr(const std::string& key) const
      * @brief       This function return string which matched key in a AMLData's AMLMap.
@@ -243,6 +354,19 @@ public:
     AMLValueType                    getValueType(const std::string& key) const;
 
 private:
+    friend class AMLObject;         // creates AMLData with the key table of a model
+    friend class Representation;
+    friend class AMLValue;          // relocates AMLData in an arena
+
+    /**
+     * @brief       Constructor with interned keys of a model, which is used by Representation.
+     *              Keys in keyTable are kept as symbol ids. AMLData added by emplaceData() use the same table and arena.
+     * @param       keyTable    [in] Key table of a model.
+     * @param       arena       [in] Arena where values are allocated, or null to allocate them on the heap.
+     *                               Copies and moves of AMLData in an arena are allocated on the heap.
+     */
+    explicit AMLData(const std::shared_ptr<const AMLKeyTable>& keyTable, AMLArena* arena = nullptr);
+
     /**
      * @fn void copyData(AMLData* target) const
      * @brief       This function copy AMLValue Data 
@@ -250,7 +374,17 @@ private:
      */
     void                            copyData(AMLData* target) const;
 
-    std::map<std::string, AMLValue*> m_values;
+    struct Values;
+
+    // moves the values of t without copying them out of an arena, unlike the move constructor.
+    void                            relocate(AMLData& t) noexcept;
+
+    const AMLValue*                 findValue(const std::string& key) const;
+    Values&                         mutableValues();
+    template <typename T>
+    void                            insertValue(const std::string& key, T&& value);
+
+    std::shared_ptr<Values>         m_values;   // shared by copies until one of them is modified
 };
 
 } // namespace AML
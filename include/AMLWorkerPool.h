@@ -0,0 +1,98 @@
+/*******************************************************************************
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *******************************************************************************/
+
+#ifndef AML_WORKER_POOL_H_
+#define AML_WORKER_POOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace AML
+{
+
+/**
+ * @class AMLWorkerPool
+ * @brief This class runs the items of a batch on a pool of threads.
+ *        Representation shards a batch conversion across the threads of a pool,
+ *        and each thread keeps its own scratch buffers of conversion for the next batch until it is stopped.
+ *        The buffers keep the capacity of the largest item converted by the thread, except protobuf messages over 1 MiB, which are released.
+ *        A pool runs one batch at a time, so run() called by other threads waits until the running batch is finished.
+ */
+class AMLWorkerPool
+{
+public:
+    /**
+     * @brief       Constructor. Worker threads are started, which wait for a batch.
+     * @param       threadCount [in] Number of threads working on a batch, including the thread calling run().
+     *                               If it is 0, the number of cores is used.
+     */
+    explicit AMLWorkerPool(size_t threadCount = 0);
+
+    /**
+     * @brief       Destructor. Worker threads are stopped and joined.
+     */
+    virtual ~AMLWorkerPool(void);
+
+    /**
+     * @fn size_t threadCount() const
+     * @brief       This function returns the number of threads working on a batch, including the thread calling run().
+     * @return      Number of threads.
+     */
+    size_t                          threadCount() const;
+
+    /**
+     * @fn void run(size_t count, const std::function<void(size_t)>& task)
+     * @brief       This function calls task with each index of [0, count) on the threads of the pool, including the calling thread,
+     *              and returns when all of them are finished. Indices are taken in ranges of consecutive ones, in no particular order.
+     * @param       count   [in] Number of items in the batch.
+     * @param       task    [in] Function called with the index of an item, which is called concurrently.
+     * @exception   If task throws an exception, the items which are not started yet are skipped and the exception is rethrown.
+     */
+    void                            run(size_t count, const std::function<void(size_t)>& task);
+
+private:
+    AMLWorkerPool(const AMLWorkerPool&) = delete;
+    AMLWorkerPool& operator=(const AMLWorkerPool&) = delete;
+
+    void                            work();
+    void                            runTasks();
+    void                            stop();
+
+    std::vector<std::thread>        m_threads;      // worker threads, without the thread calling run()
+    std::mutex                      m_runMutex;     // held while a batch runs
+    std::mutex                      m_mutex;        // guards the batch below
+    std::condition_variable         m_started;
+    std::condition_variable         m_finished;
+    const std::function<void(size_t)>* m_task;
+    size_t                          m_count;
+    size_t                          m_grain;        // number of indices taken at once
+    std::atomic<size_t>             m_next;         // next index to be taken
+    size_t                          m_generation;   // incremented for each batch
+    size_t                          m_busyCount;    // worker threads which are not finished with the batch
+    std::exception_ptr              m_error;
+    bool                            m_stopped;
+};
+
+} // namespace AML
+
+#endif // AML_WORKER_POOL_H_
@@ -19,8 +19,11 @@
 #define REPRESENTAITON_H_
 
 #include <string>
+#include <vector>
 
 #include "AMLInterface.h"
+#include "AMLArena.h"
+#include "AMLWorkerPool.h"
 
 namespace AML
 {
@@ -28,6 +31,9 @@ namespace AML
 /**
  *  @class  Representation
  *  @brief  This class converts between AMLObject, AML(XML) string, AML(Protobuf) byte.
+ *          Const methods can be called concurrently by multiple threads with the same Representation,
+ *          as the model is not changed after construction and each thread converts with scratch buffers of its own.
+ *          AMLObjects and buffers passed to them must not be modified by other threads during the call.
  *  @see AMLObject
  */
 class Representation
@@ -38,6 +44,35 @@ public:
      * @param       amlFilePath [in] File path of AML that contains a data model information.
      */
     Representation(const std::string amlFilePath);
+
+    /**
+     * @brief       Constructor, which loads the model compiled from the same AML from a cache file, so that startup does not parse and compile the model.
+     *              Otherwise the model is compiled from AML and written to the cache file.
+     * @param       amlFilePath  [in] File path of AML that contains a data model information.
+     * @param       cacheDirPath [in] Directory of compiled-model cache files, which are named by the content hash of AML.
+     * @exception   AMLException If AML is not valid. Failure to read or write the cache file is not an error.
+     * @note        The model loaded from a cache file is parsed on the first call of getConfigInfo() or DataToByte(), which need the whole model.
+     */
+    Representation(const std::string amlFilePath, const std::string cacheDirPath);
+
+    /**
+     * @brief       Constructor, which parses AML in a buffer instead of a file, e.g. a model received by a message.
+     * @param       amlBuffer [in] Buffer of AML that contains a data model information, which is copied by the constructor.
+     * @param       size      [in] Size of amlBuffer.
+     * @exception   AMLException If amlBuffer is null, or it is not valid XML or AML.
+     */
+    Representation(const char* amlBuffer, size_t size);
+
+    /**
+     * @brief       Constructor, which parses AML in a buffer, optionally in place without copying it.
+     * @param       amlBuffer    [in] Buffer of AML that contains a data model information.
+     * @param       size         [in] Size of amlBuffer.
+     * @param       parseInPlace [in] If true, amlBuffer is parsed in place. Otherwise it is copied, same as the constructor with const buffer.
+     * @exception   AMLException If amlBuffer is null, or it is not valid XML or AML.
+     * @note        If amlBuffer is parsed in place, its contents are modified and the model refers to them,
+     *              so it should not be modified or freed until Representation is destroyed.
+     */
+    Representation(char* amlBuffer, size_t size, bool parseInPlace);
     virtual ~Representation(void);
 
     /**
@@ -49,6 +84,17 @@ public:
      */
     std::string DataToAml(const AMLObject& amlObject) const;
 
+    /**
+     * @fn void DataToAml(const AMLObject& amlObject, std::string& out) const
+     * @brief       This function converts AMLObject to AML(XML) string and appends it to a buffer owned by the caller.
+     *              The buffer can be cleared and reused for a stream of events, so that its capacity is kept.
+     * @param       amlObject [in] AMLObject to be converted.
+     * @param       out       [out] String buffer that AML(XML) string is appended to.
+     * @exception   AMLException If the schema of amlObject does not match to AML model information
+     * @note        If an exception is thrown, out is restored to its size before the call.
+     */
+    void DataToAml(const AMLObject& amlObject, std::string& out) const;
+
     /**
      * @fn AMLObject* AmlToData(const std::string& xmlStr) const
      * @brief       This function converts AML(XML) string to AMLObject to match the AML model information which is set by constructor.
@@ -59,6 +105,66 @@ public:
      */
     AMLObject* AmlToData(const std::string& xmlStr) const;
 
+    /**
+     * @fn AMLObject* AmlToData(const std::string& xmlStr, AMLArena& arena) const
+     * @brief       This function converts AML(XML) string to AMLObject which is allocated in the arena.
+     * @param       xmlStr [in] AML(XML) string to be converted.
+     * @param       arena  [in] Arena where AMLObject and its AMLData are allocated.
+     * @return      AMLObject instance converted from AML(XML) string.
+     * @exception   AMLException If the schema of xmlStr does not match to AML model information
+     * @note        AMLObject instance is owned by the arena, so it should not be deleted. It is valid until arena.reset().
+     *              Copy it to keep the data after reset().
+     */
+    AMLObject* AmlToData(const std::string& xmlStr, AMLArena& arena) const;
+
+    /**
+     * @fn void AmlToData(const std::string& xmlStr, AMLObject& amlObject) const
+     * @brief       This function converts AML(XML) string into an existing AMLObject, which is reused for a stream of events.
+     *              Storage of AMLData in amlObject is reused in the same order, so that decoding the same schema again rarely allocates memory.
+     * @param       xmlStr    [in] AML(XML) string to be converted.
+     * @param       amlObject [out] AMLObject whose ids and AMLData are replaced with the converted ones.
+     * @exception   AMLException If the schema of xmlStr does not match to AML model information
+     * @note        If an exception is thrown, amlObject may have a part of the converted AMLData.
+     */
+    void AmlToData(const std::string& xmlStr, AMLObject& amlObject) const;
+
+    /**
+     * @fn AMLObject* AmlToData(char* buffer, size_t size) const
+     * @brief       This function converts AML(XML) text in a buffer to AMLObject to match the AML model information which is set by constructor.
+     *              The buffer is parsed in place, without being copied.
+     * @param       buffer [in] Buffer of AML(XML) text owned by the caller. Its contents can be modified during the conversion.
+     * @param       size   [in] Size of AML(XML) text in bytes.
+     * @return      AMLObject instance converted from AML(XML) text.
+     * @exception   AMLException If the schema of AML(XML) text does not match to AML model information
+     * @note        AMLObject instance will be allocated and returned, so it should be deleted after use.
+     */
+    AMLObject* AmlToData(char* buffer, size_t size) const;
+
+    /**
+     * @fn AMLObject* AmlToData(char* buffer, size_t size, AMLArena& arena) const
+     * @brief       This function converts AML(XML) text in a buffer to AMLObject which is allocated in the arena.
+     *              The buffer is parsed in place, without being copied.
+     * @param       buffer [in] Buffer of AML(XML) text owned by the caller. Its contents can be modified during the conversion.
+     * @param       size   [in] Size of AML(XML) text in bytes.
+     * @param       arena  [in] Arena where AMLObject and its AMLData are allocated.
+     * @return      AMLObject instance converted from AML(XML) text.
+     * @exception   AMLException If the schema of AML(XML) text does not match to AML model information
+     * @note        AMLObject instance is owned by the arena, so it should not be deleted. It is valid until arena.reset().
+     */
+    AMLObject* AmlToData(char* buffer, size_t size, AMLArena& arena) const;
+
+    /**
+     * @fn void AmlToData(char* buffer, size_t size, AMLObject& amlObject) const
+     * @brief       This function converts AML(XML) text in a buffer into an existing AMLObject, which is reused for a stream of events.
+     *              The buffer is parsed in place, without being copied.
+     * @param       buffer    [in] Buffer of AML(XML) text owned by the caller. Its contents can be modified during the conversion.
+     * @param       size      [in] Size of AML(XML) text in bytes.
+     * @param       amlObject [out] AMLObject whose ids and AMLData are replaced with the converted ones.
+     * @exception   AMLException If the schema of AML(XML) text does not match to AML model information
+     * @note        If an exception is thrown, amlObject may have a part of the converted AMLData.
+     */
+    void AmlToData(char* buffer, size_t size, AMLObject& amlObject) const;
+
     /**
      * @fn std::string DataToByte(const AMLObject& amlObject) const
      * @brief       This function converts AMLObject to Protobuf byte data to match the AML model information which is set by constructor.
@@ -69,6 +175,18 @@ public:
      */
     std::string DataToByte(const AMLObject& amlObject) const;
 
+    /**
+     * @fn void DataToByte(const AMLObject& amlObject, std::string& out) const
+     * @brief       This function converts AMLObject to Protobuf byte data and appends it to a buffer owned by the caller.
+     *              The buffer can be cleared and reused for a stream of events, so that its capacity is kept.
+     * @param       amlObject [in] AMLObject to be converted.
+     * @param       out       [out] String buffer that Protobuf byte data is appended to.
+     * @exception   AMLException If the schema of amlObject does not match to AML model information
+     * @node        If 'disable_protobuf' build option is enabled, this API will be DISABLED and throw AMLException with code 'API_NOT_ENABLED'.
+     * @note        If an exception is thrown, out is restored to its size before the call.
+     */
+    void DataToByte(const AMLObject& amlObject, std::string& out) const;
+
     /**
      * @fn AMLObject* ByteToData(const std::string& byte) const
      * @brief       This function converts Protobuf byte data to AMLObject to match the AML model information which is set by constructor.
@@ -80,6 +198,130 @@ public:
      */
     AMLObject* ByteToData(const std::string& byte) const;
 
+    /**
+     * @fn AMLObject* ByteToData(const std::string& byte, AMLArena& arena) const
+     * @brief       This function converts Protobuf byte data to AMLObject which is allocated in the arena.
+     * @param       byte  [in] Protobuf byte data(string) to be converted.
+     * @param       arena [in] Arena where AMLObject and its AMLData are allocated.
+     * @return      AMLObject instance converted from amlObject.
+     * @exception   AMLException If the schema of byte does not match to AML model information
+     * @node        If 'disable_protobuf' build option is enabled, this API will be DISABLED and throw AMLException with code 'API_NOT_ENABLED'.
+     * @note        AMLObject instance is owned by the arena, so it should not be deleted. It is valid until arena.reset().
+     */
+    AMLObject* ByteToData(const std::string& byte, AMLArena& arena) const;
+
+    /**
+     * @fn void ByteToData(const std::string& byte, AMLObject& amlObject) const
+     * @brief       This function converts Protobuf byte data into an existing AMLObject, which is reused for a stream of events.
+     *              Storage of AMLData in amlObject is reused in the same order, so that decoding the same schema again rarely allocates memory.
+     * @param       byte      [in] Protobuf byte data(string) to be converted.
+     * @param       amlObject [out] AMLObject whose ids and AMLData are replaced with the converted ones.
+     * @exception   AMLException If the schema of byte does not match to AML model information
+     * @node        If 'disable_protobuf' build option is enabled, this API will be DISABLED and throw AMLException with code 'API_NOT_ENABLED'.
+     * @note        If an exception is thrown, amlObject may have a part of the converted AMLData.
+     */
+    void ByteToData(const std::string& byte, AMLObject& amlObject) const;
+
+    /**
+     * @fn void DataToAml(const std::vector<AMLObject>& amlObjects, std::vector<std::string>& out) const
+     * @brief       This function converts AMLObjects to AML(XML) strings in a batch.
+     *              The strings in out are cleared and reused, so that their capacity is kept for the next batch.
+     * @param       amlObjects [in] AMLObjects to be converted.
+     * @param       out        [out] AML(XML) strings converted from amlObjects, in the same order.
+     * @exception   AMLException If the schema of any AMLObject does not match to AML model information
+     * @note        If an exception is thrown, out has the strings of the AMLObjects before the failed one, so its size is the index of it.
+     */
+    void DataToAml(const std::vector<AMLObject>& amlObjects, std::vector<std::string>& out) const;
+
+    /**
+     * @fn void AmlToData(const std::vector<std::string>& xmlStrs, std::vector<AMLObject>& out) const
+     * @brief       This function converts AML(XML) strings to AMLObjects in a batch.
+     *              AMLObjects in out are reused as AmlToData(xmlStr, amlObject) does, so that decoding batches of the same schema rarely allocates memory.
+     * @param       xmlStrs    [in] AML(XML) strings to be converted.
+     * @param       out        [out] AMLObjects converted from xmlStrs, in the same order.
+     * @exception   AMLException If the schema of any AML(XML) string does not match to AML model information
+     * @note        If an exception is thrown, out has the AMLObjects of the strings before the failed one, so its size is the index of it.
+     */
+    void AmlToData(const std::vector<std::string>& xmlStrs, std::vector<AMLObject>& out) const;
+
+    /**
+     * @fn void DataToByte(const std::vector<AMLObject>& amlObjects, std::vector<std::string>& out) const
+     * @brief       This function converts AMLObjects to Protobuf byte data in a batch.
+     *              The strings in out are cleared and reused, so that their capacity is kept for the next batch.
+     * @param       amlObjects [in] AMLObjects to be converted.
+     * @param       out        [out] Protobuf byte data(string) converted from amlObjects, in the same order.
+     * @exception   AMLException If the schema of any AMLObject does not match to AML model information
+     * @node        If 'disable_protobuf' build option is enabled, this API will be DISABLED and throw AMLException with code 'API_NOT_ENABLED'.
+     * @note        If an exception is thrown, out has the byte data of the AMLObjects before the failed one, so its size is the index of it.
+     * @note        Each converting thread keeps its protobuf message for the next conversion, unless it has grown over 1 MiB.
+     */
+    void DataToByte(const std::vector<AMLObject>& amlObjects, std::vector<std::string>& out) const;
+
+    /**
+     * @fn void ByteToData(const std::vector<std::string>& bytes, std::vector<AMLObject>& out) const
+     * @brief       This function converts Protobuf byte data to AMLObjects in a batch.
+     *              AMLObjects in out are reused as ByteToData(byte, amlObject) does, so that decoding batches of the same schema rarely allocates memory.
+     * @param       bytes      [in] Protobuf byte data(string) to be converted.
+     * @param       out        [out] AMLObjects converted from bytes, in the same order.
+     * @exception   AMLException If the schema of any byte data does not match to AML model information
+     * @node        If 'disable_protobuf' build option is enabled, this API will be DISABLED and throw AMLException with code 'API_NOT_ENABLED'.
+     * @note        If an exception is thrown, out has the AMLObjects of the byte data before the failed one, so its size is the index of it.
+     * @note        Each converting thread keeps its protobuf message for the next conversion, unless it has grown over 1 MiB.
+     */
+    void ByteToData(const std::vector<std::string>& bytes, std::vector<AMLObject>& out) const;
+
+    /**
+     * @fn void DataToAml(const std::vector<AMLObject>& amlObjects, std::vector<std::string>& out, AMLWorkerPool& pool) const
+     * @brief       This function converts AMLObjects to AML(XML) strings in a batch, which is shared by the threads of pool.
+     *              The results are the same as DataToAml(amlObjects, out), in the order of amlObjects.
+     * @param       amlObjects [in] AMLObjects to be converted, which are read concurrently.
+     * @param       out        [out] AML(XML) strings converted from amlObjects, in the same order.
+     * @param       pool       [in] Pool of threads which convert the items of the batch.
+     * @exception   AMLException If the schema of any AMLObject does not match to AML model information
+     * @note        If an exception is thrown, out has the strings of the AMLObjects before the first failed one, so its size is the index of it.
+     */
+    void DataToAml(const std::vector<AMLObject>& amlObjects, std::vector<std::string>& out, AMLWorkerPool& pool) const;
+
+    /**
+     * @fn void AmlToData(const std::vector<std::string>& xmlStrs, std::vector<AMLObject>& out, AMLWorkerPool& pool) const
+     * @brief       This function converts AML(XML) strings to AMLObjects in a batch, which is shared by the threads of pool.
+     *              The results are the same as AmlToData(xmlStrs, out), in the order of xmlStrs.
+     * @param       xmlStrs    [in] AML(XML) strings to be converted.
+     * @param       out        [out] AMLObjects converted from xmlStrs, in the same order. They must not be shared with copies used by other threads.
+     * @param       pool       [in] Pool of threads which convert the items of the batch.
+     * @exception   AMLException If the schema of any AML(XML) string does not match to AML model information
+     * @note        If an exception is thrown, out has the AMLObjects of the strings before the first failed one, so its size is the index of it.
+     */
+    void AmlToData(const std::vector<std::string>& xmlStrs, std::vector<AMLObject>& out, AMLWorkerPool& pool) const;
+
+    /**
+     * @fn void DataToByte(const std::vector<AMLObject>& amlObjects, std::vector<std::string>& out, AMLWorkerPool& pool) const
+     * @brief       This function converts AMLObjects to Protobuf byte data in a batch, which is shared by the threads of pool.
+     *              The results are the same as DataToByte(amlObjects, out), in the order of amlObjects.
+     * @param       amlObjects [in] AMLObjects to be converted, which are read concurrently.
+     * @param       out        [out] Protobuf byte data(string) converted from amlObjects, in the same order.
+     * @param       pool       [in] Pool of threads which convert the items of the batch.
+     * @exception   AMLException If the schema of any AMLObject does not match to AML model information
+     * @node        If 'disable_protobuf' build option is enabled, this API will be DISABLED and throw AMLException with code 'API_NOT_ENABLED'.
+     * @note        If an exception is thrown, out has the byte data of the AMLObjects before the first failed one, so its size is the index of it.
+     * @note        Each converting thread keeps its protobuf message for the next conversion, unless it has grown over 1 MiB.
+     */
+    void DataToByte(const std::vector<AMLObject>& amlObjects, std::vector<std::string>& out, AMLWorkerPool& pool) const;
+
+    /**
+     * @fn void ByteToData(const std::vector<std::string>& bytes, std::vector<AMLObject>& out, AMLWorkerPool& pool) const
+     * @brief       This function converts Protobuf byte data to AMLObjects in a batch, which is shared by the threads of pool.
+     *              The results are the same as ByteToData(bytes, out), in the order of bytes.
+     * @param       bytes      [in] Protobuf byte data(string) to be converted.
+     * @param       out        [out] AMLObjects converted from bytes, in the same order. They must not be shared with copies used by other threads.
+     * @param       pool       [in] Pool of threads which convert the items of the batch.
+     * @exception   AMLException If the schema of any byte data does not match to AML model information
+     * @node        If 'disable_protobuf' build option is enabled, this API will be DISABLED and throw AMLException with code 'API_NOT_ENABLED'.
+     * @note        If an exception is thrown, out has the AMLObjects of the byte data before the first failed one, so its size is the index of it.
+     * @note        Each converting thread keeps its protobuf message for the next conversion, unless it has grown over 1 MiB.
+     */
+    void ByteToData(const std::vector<std::string>& bytes, std::vector<AMLObject>& out, AMLWorkerPool& pool) const;
+
     /**
      * @fn std::string getRepresentationId() const
      * @brief       This function returns AutomationML SystemUnitClassLib's unique ID
@@ -96,6 +338,14 @@ public:
     AMLObject* getConfigInfo() const;
 
 private:
+    AMLObject* amlToData(const std::string& xmlStr, AMLObject* target, AMLArena* arena) const;
+    AMLObject* amlToData(char* buffer, size_t size, AMLObject* target, AMLArena* arena) const;
+    AMLObject* byteToData(const std::string& byte, AMLObject* target, AMLArena* arena) const;
+    void dataToAml(const std::vector<AMLObject>& amlObjects, std::vector<std::string>& out, AMLWorkerPool* pool) const;
+    void amlToData(const std::vector<std::string>& xmlStrs, std::vector<AMLObject>& out, AMLWorkerPool* pool) const;
+    void dataToByte(const std::vector<AMLObject>& amlObjects, std::vector<std::string>& out, AMLWorkerPool* pool) const;
+    void byteToData(const std::vector<std::string>& bytes, std::vector<AMLObject>& out, AMLWorkerPool* pool) const;
+
     class AMLModel;
     AMLModel* m_amlModel;
 };
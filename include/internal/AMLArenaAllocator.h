@@ -0,0 +1,107 @@
+/*******************************************************************************
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *******************************************************************************/
+
+#ifndef AML_ARENA_ALLOCATOR_H_
+#define AML_ARENA_ALLOCATOR_H_
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+#include "AMLArena.h"
+
+namespace AML
+{
+
+/**
+ * @class AMLArenaAllocator
+ * @brief This class is an allocator of containers, which allocates memory in an arena or on the heap if the arena is null.
+ *        Memory in the arena is released by AMLArena::reset(), so deallocate() does nothing for it.
+ *        Copy of a container is allocated on the heap, so that it can be used after reset().
+ */
+template <typename T>
+class AMLArenaAllocator
+{
+public:
+    typedef T value_type;
+    typedef std::false_type propagate_on_container_copy_assignment;
+    typedef std::true_type  propagate_on_container_move_assignment;
+    typedef std::true_type  propagate_on_container_swap;
+
+    AMLArenaAllocator(void) noexcept : m_arena(nullptr)
+    {
+    }
+
+    explicit AMLArenaAllocator(AMLArena* arena) noexcept : m_arena(arena)
+    {
+    }
+
+    template <typename U>
+    AMLArenaAllocator(const AMLArenaAllocator<U>& t) noexcept : m_arena(t.arena())
+    {
+    }
+
+    T* allocate(size_t n)
+    {
+        if (nullptr != m_arena)
+        {
+            return static_cast<T*>(m_arena->allocate(n * sizeof(T), alignof(T)));
+        }
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    void deallocate(T* p, size_t) noexcept
+    {
+        if (nullptr == m_arena)
+        {
+            ::operator delete(p);
+        }
+    }
+
+    AMLArenaAllocator select_on_container_copy_construction() const
+    {
+        return AMLArenaAllocator();
+    }
+
+    AMLArena* arena() const
+    {
+        return m_arena;
+    }
+
+private:
+    AMLArena* m_arena;
+};
+
+template <typename T, typename U>
+inline bool operator==(const AMLArenaAllocator<T>& a, const AMLArenaAllocator<U>& b)
+{
+    return a.arena() == b.arena();
+}
+
+template <typename T, typename U>
+inline bool operator!=(const AMLArenaAllocator<T>& a, const AMLArenaAllocator<U>& b)
+{
+    return a.arena() != b.arena();
+}
+
+template <typename T>
+using AMLArenaVector = std::vector<T, AMLArenaAllocator<T>>;
+
+} // namespace AML
+
+#endif // AML_ARENA_ALLOCATOR_H_
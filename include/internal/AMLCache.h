@@ -0,0 +1,175 @@
+/*******************************************************************************
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *******************************************************************************/
+
+#ifndef AML_CACHE_H_
+#define AML_CACHE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace AML
+{
+
+/**
+ * @fn uint64_t hashContent(const char* data, size_t size)
+ * @brief       This function returns the 64-bit hash (XXH64 with seed 0) of data, which keys a cache to the content it is compiled from.
+ * @param       data    [in] Content to hash.
+ * @param       size    [in] Size of data.
+ * @return      Hash of data.
+ */
+uint64_t hashContent(const char* data, size_t size);
+
+/**
+ * @class AMLCacheWriter
+ * @brief This class appends values to a binary cache in a fixed little-endian layout.
+ */
+class AMLCacheWriter
+{
+public:
+    /**
+     * @brief       Constructor.
+     * @param       out     [out] String which values are appended to.
+     */
+    explicit AMLCacheWriter(std::string& out);
+
+    void                            writeU8(uint8_t value);
+    void                            writeU32(uint32_t value);
+    void                            writeU64(uint64_t value);
+
+    /**
+     * @fn void writeString(const std::string& value)
+     * @brief       This function appends the size of value and its bytes.
+     * @param       value   [in] String to append.
+     */
+    void                            writeString(const std::string& value);
+
+    /**
+     * @fn void writeString(const char* data, size_t size)
+     * @brief       This function appends the size and the bytes of data.
+     * @param       data    [in] Bytes to append.
+     * @param       size    [in] Size of data.
+     */
+    void                            writeString(const char* data, size_t size);
+
+private:
+    std::string&                    m_out;
+};
+
+/**
+ * @class AMLCacheReader
+ * @brief This class reads values written by AMLCacheWriter from a buffer, which is typically a mapped cache file.
+ *        Reading beyond the buffer fails, so that a truncated cache is detected.
+ */
+class AMLCacheReader
+{
+public:
+    /**
+     * @brief       Constructor.
+     * @param       begin   [in] Beginning of the buffer.
+     * @param       end     [in] End of the buffer.
+     */
+    AMLCacheReader(const char* begin, const char* end);
+
+    bool                            readU8(uint8_t& value);
+    bool                            readU32(uint32_t& value);
+    bool                            readU64(uint64_t& value);
+
+    /**
+     * @fn bool readString(std::string& value)
+     * @brief       This function reads a string written by writeString().
+     * @param       value   [out] String read.
+     * @return      false if the buffer ends before the string.
+     */
+    bool                            readString(std::string& value);
+
+    /**
+     * @fn bool readString(const char*& data, size_t& size)
+     * @brief       This function reads a string written by writeString() without copying it.
+     * @param       data    [out] Bytes of the string in the buffer.
+     * @param       size    [out] Size of the string.
+     * @return      false if the buffer ends before the string.
+     */
+    bool                            readString(const char*& data, size_t& size);
+
+    /**
+     * @fn bool readBytes(size_t size, const char*& data)
+     * @brief       This function reads bytes of the size without copying them.
+     * @param       size    [in] Number of bytes.
+     * @param       data    [out] Bytes in the buffer.
+     * @return      false if the buffer ends before the bytes.
+     */
+    bool                            readBytes(size_t size, const char*& data);
+
+    /**
+     * @fn bool atEnd() const
+     * @brief       This function returns whether all bytes of the buffer are read.
+     * @return      true if the buffer is read to its end.
+     */
+    bool                            atEnd() const;
+
+private:
+    bool                            readUnsigned(size_t size, uint64_t& value);
+
+    const char*                     m_pos;
+    const char*                     m_end;
+};
+
+/**
+ * @class AMLMappedFile
+ * @brief This class maps a file into memory read-only, so that the pages of a cache are shared by processes using it.
+ *        Where mmap is not available, the file is read into memory.
+ */
+class AMLMappedFile
+{
+public:
+    AMLMappedFile(void);
+    ~AMLMappedFile(void);
+
+    /**
+     * @fn bool open(const std::string& filePath)
+     * @brief       This function maps a file, replacing the file mapped before.
+     * @param       filePath    [in] Path of the file.
+     * @return      false if the file can not be opened or mapped.
+     */
+    bool                            open(const std::string& filePath);
+
+    const char*                     data() const
+    {
+        return m_data;
+    }
+
+    size_t                          size() const
+    {
+        return m_size;
+    }
+
+private:
+    AMLMappedFile(const AMLMappedFile&) = delete;
+    AMLMappedFile& operator=(const AMLMappedFile&) = delete;
+
+    void                            close();
+
+    const char*                     m_data;
+    size_t                          m_size;
+    bool                            m_mapped;   // m_data is mapped, otherwise it is m_buffer
+    std::string                     m_buffer;
+};
+
+} // namespace AML
+
+#endif // AML_CACHE_H_
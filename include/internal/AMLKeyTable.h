@@ -0,0 +1,78 @@
+/*******************************************************************************
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *******************************************************************************/
+
+#ifndef AML_KEY_TABLE_H_
+#define AML_KEY_TABLE_H_
+
+#include <string>
+#include <vector>
+
+namespace AML
+{
+
+/**
+ * @class AMLKeyTable
+ * @brief This class interns the attribute names defined by a model, so that AMLData keeps a symbol id instead of a key string.
+ *        Ids are in the order of names, so that ids of the same table are compared instead of names.
+ *        The table is not modified after construction, so that it can be shared by AMLData of multiple threads.
+ */
+class AMLKeyTable
+{
+public:
+    /**
+     * @brief       Constructor.
+     * @param       keys    [in] Names to be interned. Duplicated names are allowed.
+     */
+    explicit AMLKeyTable(std::vector<std::string> keys);
+
+    /**
+     * @fn bool find(const std::string& key, unsigned int& id) const
+     * @brief       This function finds the symbol id of key.
+     * @param       key     [in] Name to find.
+     * @param       id      [out] Symbol id of key.
+     * @return      true if key is interned.
+     */
+    bool                            find(const std::string& key, unsigned int& id) const;
+
+    /**
+     * @fn const std::string& key(unsigned int id) const
+     * @brief       This function returns the name of symbol id.
+     * @param       id      [in] Symbol id less than size().
+     * @return      Interned name.
+     */
+    const std::string&              key(unsigned int id) const
+    {
+        return m_keys[id];
+    }
+
+    /**
+     * @fn unsigned int size() const
+     * @brief       This function returns the number of interned names.
+     * @return      Number of names, which is the upper bound of symbol ids.
+     */
+    unsigned int                    size() const
+    {
+        return (unsigned int)m_keys.size();
+    }
+
+private:
+    std::vector<std::string>        m_keys;     // sorted and unique
+};
+
+} // namespace AML
+
+#endif // AML_KEY_TABLE_H_
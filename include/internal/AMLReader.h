@@ -0,0 +1,149 @@
+/*******************************************************************************
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *******************************************************************************/
+
+#ifndef AML_READER_H_
+#define AML_READER_H_
+
+#include <string>
+#include <vector>
+
+namespace AML
+{
+
+/**
+ * @class AMLReader
+ * @brief This class tokenizes XML text in a buffer without building a DOM.
+ *        Values are decoded as pugixml does with its default parse options.
+ *        It reports Unsupported for malformed XML and for constructs it does not handle(DOCTYPE, ambiguous entities, ...),
+ *        so that the caller can fall back to pugixml, which reports the exact error.
+ */
+class AMLReader
+{
+public:
+    /**
+     * @class Token
+     * @brief This class represent the type of token read by next().
+     */
+    enum class Token
+    {
+        StartElement = 0,   // start tag; name and attributes are available until next()
+        EndElement,         // end tag, or the end of an empty-element tag
+        Text,               // PCDATA which is not whitespace only
+        CData,              // CDATA section
+        EndOfDocument,      // end of buffer with a single root element
+        Unsupported         // malformed or unsupported XML; reader stops here
+    };
+
+    /**
+     * @brief       Constructor.
+     * @param       begin   [in] Beginning of XML text.
+     * @param       end     [in] End of XML text.
+     */
+    AMLReader(const char* begin, const char* end);
+
+    /**
+     * @fn void reset(const char* begin, const char* end)
+     * @brief       This function starts to read another XML text, keeping the buffers of the reader to be reused.
+     * @param       begin   [in] Beginning of XML text.
+     * @param       end     [in] End of XML text.
+     */
+    void                    reset(const char* begin, const char* end);
+
+    /**
+     * @fn Token next()
+     * @brief       This function reads the next token.
+     * @return      Type of token.
+     */
+    Token                   next();
+
+    /**
+     * @fn bool skipElement()
+     * @brief       This function skips children of the element started last, until its end tag.
+     * @return      false if the children are malformed or unsupported.
+     */
+    bool                    skipElement();
+
+    /**
+     * @fn bool isName(const char* name) const
+     * @brief       This function checks the name of the current element.
+     * @param       name    [in] Element name.
+     * @return      true if the name is the same.
+     */
+    bool                    isName(const char* name) const;
+
+    /**
+     * @fn bool attribute(const char* name, std::string& value) const
+     * @brief       This function gets the decoded value of the first attribute of the name in the current start tag.
+     * @param       name    [in] Attribute name.
+     * @param       value   [out] Decoded attribute value. It is cleared if the attribute does not exist.
+     * @return      true if the attribute exists.
+     */
+    bool                    attribute(const char* name, std::string& value) const;
+
+    /**
+     * @fn bool hasAttribute(const char* name, const char* value) const
+     * @brief       This function checks whether any attribute of the name in the current start tag has the value.
+     * @param       name    [in] Attribute name.
+     * @param       value   [in] Decoded attribute value.
+     * @return      true if the attribute exists.
+     */
+    bool                    hasAttribute(const char* name, const char* value) const;
+
+    /**
+     * @fn void text(std::string& value) const
+     * @brief       This function gets the decoded value of the current Text or CData token.
+     * @param       value   [out] Decoded value.
+     */
+    void                    text(std::string& value) const;
+
+private:
+    struct Span
+    {
+        const char*     begin;
+        const char*     end;
+    };
+
+    struct Attribute
+    {
+        Span            name;
+        Span            value;
+    };
+
+    Token                   unsupported();
+    Token                   readStartTag();
+    Token                   readEndTag();
+    bool                    readText();
+    bool                    readMarkup();
+    static bool             scanEscape(const char*& pos, const char* end);
+
+    static void             decode(std::string& out, const char* begin, const char* end, bool isAttribute, bool hasEscapes);
+    static bool             equals(const Span& span, const char* str);
+
+    const char*             m_pos;
+    const char*             m_end;
+    Token                   m_token;
+    Span                    m_name;             // element name of StartElement/EndElement
+    Span                    m_text;             // raw value of Text/CData
+    std::vector<Attribute>  m_attributes;
+    std::vector<Span>       m_openElements;
+    bool                    m_emptyElement;     // EndElement is pending for <name ... />
+    bool                    m_hasRoot;
+};
+
+} // namespace AML
+
+#endif // AML_READER_H_
@@ -0,0 +1,48 @@
+/*******************************************************************************
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *******************************************************************************/
+
+#ifndef AML_SHARED_H_
+#define AML_SHARED_H_
+
+#include <atomic>
+#include <memory>
+
+namespace AML
+{
+
+/**
+ * @fn bool isUnique(const std::shared_ptr<T>& ptr)
+ * @brief       This function checks whether ptr is the only owner of the object, so that the object can be modified in place.
+ *              use_count() is read without synchronization, so the fence orders the following accesses
+ *              after the accesses of the other owners released already.
+ * @param       ptr     [in] Non-null shared pointer.
+ * @return      true if no other shared pointer owns the object.
+ */
+template <typename T>
+inline bool isUnique(const std::shared_ptr<T>& ptr)
+{
+    if (ptr.use_count() != 1)
+    {
+        return false;
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return true;
+}
+
+} // namespace AML
+
+#endif // AML_SHARED_H_
@@ -0,0 +1,168 @@
+/*******************************************************************************
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *******************************************************************************/
+
+#ifndef AML_TEMPLATE_H_
+#define AML_TEMPLATE_H_
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+#include "AMLInterface.h"
+
+namespace AML
+{
+
+class AMLTemplate;
+class AMLCacheWriter;
+class AMLCacheReader;
+
+typedef std::unordered_map<std::string, AMLTemplate> AMLTemplateMap;
+
+/**
+ * @class AMLTemplate
+ * @brief This class is a pre-rendered XML text of a SystemUnitClass with slots for values.
+ *        Static text is rendered once by AMLWriter, and values of AMLData(or AMLObject) are filled in the slots on render().
+ */
+class AMLTemplate
+{
+public:
+    /**
+     * @class SlotType
+     * @brief This class represent the type of value which is filled in a slot.
+     */
+    enum class SlotType
+    {
+        String = 0,     // string value of AMLData
+        StringArray,    // ordered list of AMLData, rendered as child <Attribute>s named "1", "2", "3"...
+        AMLData,        // AMLData value of AMLData, slots until the end of scope are filled with it
+        Invalid,        // <Attribute> of an invalid type, throws AMLException on render
+        DeviceId,       // device id of AMLObject
+        TimeStamp,      // timestamp of AMLObject
+        Id,             // id of AMLObject
+        DataList        // <InternalElement>s of all AMLData in AMLObject
+    };
+
+    AMLTemplate(void);
+
+    /**
+     * @fn std::string& text()
+     * @brief       This function returns static text buffer of template, in which AMLWriter writes during compile.
+     * @return      Static text buffer.
+     */
+    std::string&                    text();
+
+    /**
+     * @fn void addSlot(SlotType type, const std::string& key)
+     * @brief       This function adds a slot at the end of current static text.
+     * @param       type    [in] Slot type except StringArray, AMLData and DataList.
+     * @param       key     [in] Key of the value in AMLData.
+     */
+    void                            addSlot(SlotType type, const std::string& key = "");
+
+    /**
+     * @fn void addArraySlot(const std::string& key, const std::string& itemText, size_t indexOffset, size_t valueOffset, size_t leadLength)
+     * @brief       This function adds a slot for an ordered list at the end of current static text.
+     * @param       key         [in] Key of the value in AMLData.
+     * @param       itemText    [in] Text of an item without its index and value.
+     * @param       indexOffset [in] Offset in itemText where index("1", "2", ...) is inserted.
+     * @param       valueOffset [in] Offset in itemText where value is inserted.
+     * @param       leadLength  [in] Length of indentation which is omitted before the first item, when the list follows a text.
+     */
+    void                            addArraySlot(const std::string& key, const std::string& itemText,
+                                                 size_t indexOffset, size_t valueOffset, size_t leadLength = 0);
+
+    /**
+     * @fn void addDataListSlot(size_t leadLength)
+     * @brief       This function adds a slot for all AMLData of AMLObject at the end of current static text.
+     * @param       leadLength  [in] Length of indentation which is omitted before the first AMLData, when the list follows a text.
+     */
+    void                            addDataListSlot(size_t leadLength = 0);
+
+    /**
+     * @fn void beginDataScope(const std::string& key)
+     * @brief       This function adds a slot for AMLData value. Slots added until endDataScope() are filled with the value.
+     * @param       key     [in] Key of the value in AMLData.
+     */
+    void                            beginDataScope(const std::string& key);
+
+    /**
+     * @fn void endDataScope()
+     * @brief       This function closes the scope opened last by beginDataScope().
+     */
+    void                            endDataScope();
+
+    /**
+     * @fn void render(std::string& out, const AMLData& amlData) const
+     * @brief       This function appends text of template filled with values of amlData.
+     * @param       out     [in] String buffer that the text is appended to.
+     * @param       amlData [in] AMLData which has values of slots.
+     * @exception   AMLException If amlData does not have a value of slot or the type of value does not match.
+     */
+    void                            render(std::string& out, const AMLData& amlData) const;
+
+    /**
+     * @fn void render(std::string& out, const AMLObject& amlObject, const AMLTemplateMap& templates) const
+     * @brief       This function appends text of template filled with values of amlObject.
+     * @param       out         [in] String buffer that the text is appended to.
+     * @param       amlObject   [in] AMLObject which has values of slots.
+     * @param       templates   [in] Templates of SystemUnitClasses used to render AMLData of amlObject on DataList slot.
+     * @exception   AMLException If AMLData of amlObject does not match to templates.
+     */
+    void                            render(std::string& out, const AMLObject& amlObject, const AMLTemplateMap& templates) const;
+
+    /**
+     * @fn void save(AMLCacheWriter& writer) const
+     * @brief       This function writes the template to a compiled-model cache.
+     * @param       writer  [in] Writer of the cache.
+     */
+    void                            save(AMLCacheWriter& writer) const;
+
+    /**
+     * @fn bool load(AMLCacheReader& reader, bool forObject)
+     * @brief       This function replaces the template with the one written by save().
+     * @param       reader      [in] Reader of the cache.
+     * @param       forObject   [in] true if the template is rendered with AMLObject, or false if it is rendered with AMLData.
+     * @return      false if the cache is truncated, its slots are not consistent with the text,
+     *              or a slot can not be rendered at its position (e.g. a String slot out of AMLData).
+     */
+    bool                            load(AMLCacheReader& reader, bool forObject);
+
+private:
+    struct Slot
+    {
+        SlotType        type;
+        std::string     key;
+        size_t          offset;         // position in m_text where the value is inserted
+        size_t          scopeEnd;       // AMLData : index of the first slot after the scope
+        std::string     itemText;       // StringArray : text of an item
+        size_t          indexOffset;    // StringArray : position in itemText where index is inserted
+        size_t          valueOffset;    // StringArray : position in itemText where value is inserted
+        size_t          leadLength;     // StringArray, DataList : indentation omitted before the first item
+    };
+
+    size_t                          renderSlots(std::string& out, size_t textPos, size_t begin, size_t end,
+                                                const AMLData* amlData, const AMLObject* amlObject, const AMLTemplateMap* templates) const;
+
+    std::string                     m_text;
+    std::vector<Slot>               m_slots;
+    std::vector<size_t>             m_scopes;
+};
+
+} // namespace AML
+
+#endif // AML_TEMPLATE_H_
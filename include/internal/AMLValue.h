@@ -18,35 +18,151 @@
 #ifndef AML_VALUE_H_
 #define AML_VALUE_H_
 
+#include <new>
+#include <string>
+#include <utility>
+#include <vector>
+
 #include "AMLInterface.h"
 
 namespace AML
 {
 
 /**
- * @class AMLValue_
- * @brief This class have all types of AMLValue data.
- * @see AMLValue
+ * @class AMLValue
+ * @brief This class holds a value of AMLData, which is one of string, string array and AMLData.
+ *        The value is stored inline with its type, so that it is placed in the vector of AMLData without another allocation.
  */
-template <typename T>
-class AMLValue_ : public AMLValue
+class AMLValue
 {
 public:
-    AMLValue_ (AMLValueType t, T val) : AMLValue(t), m_value(val)
+    explicit AMLValue(const std::string& value) : m_type(AMLValueType::String)
     {
+        new (&m_string) std::string(value);
     }
-    virtual ~AMLValue_ ()
+
+    explicit AMLValue(const std::vector<std::string>& value) : m_type(AMLValueType::StringArray)
     {
+        new (&m_stringArray) std::vector<std::string>(value);
     }
 
-    T& getValue()
+    explicit AMLValue(const AMLData& value) : m_type(AMLValueType::AMLData)
     {
-        return m_value;
+        new (&m_data) AMLData(value);
     }
+
+    explicit AMLValue(std::string&& value) : m_type(AMLValueType::String)
+    {
+        new (&m_string) std::string(std::move(value));
+    }
+
+    explicit AMLValue(std::vector<std::string>&& value) : m_type(AMLValueType::StringArray)
+    {
+        new (&m_stringArray) std::vector<std::string>(std::move(value));
+    }
+
+    explicit AMLValue(AMLData&& value) : m_type(AMLValueType::AMLData)
+    {
+        new (&m_data) AMLData(std::move(value));
+    }
+
+    AMLValue(const AMLValue& t) : m_type(t.m_type)
+    {
+        switch (m_type)
+        {
+            case AMLValueType::String:      new (&m_string) std::string(t.m_string);                    break;
+            case AMLValueType::StringArray: new (&m_stringArray) std::vector<std::string>(t.m_stringArray); break;
+            case AMLValueType::AMLData:     new (&m_data) AMLData(t.m_data);                            break;
+        }
+    }
+
+    // AMLValue is moved within the values of an AMLData, so that AMLData in an arena is relocated as it is.
+    AMLValue(AMLValue&& t) noexcept : m_type(t.m_type)
+    {
+        switch (m_type)
+        {
+            case AMLValueType::String:      new (&m_string) std::string(std::move(t.m_string));                    break;
+            case AMLValueType::StringArray: new (&m_stringArray) std::vector<std::string>(std::move(t.m_stringArray)); break;
+            case AMLValueType::AMLData:     new (&m_data) AMLData(); m_data.relocate(t.m_data);                    break;
+        }
+    }
+
+    AMLValue& operator=(const AMLValue& t)
+    {
+        if (&t != this)
+        {
+            AMLValue value(t);
+            *this = std::move(value);
+        }
+        return *this;
+    }
+
+    AMLValue& operator=(AMLValue&& t) noexcept
+    {
+        if (&t != this)
+        {
+            this->~AMLValue();
+            new (this) AMLValue(std::move(t));
+        }
+        return *this;
+    }
+
+    ~AMLValue()
+    {
+        switch (m_type)
+        {
+            case AMLValueType::String:      m_string.~basic_string();   break;
+            case AMLValueType::StringArray: m_stringArray.~vector();    break;
+            case AMLValueType::AMLData:     m_data.~AMLData();          break;
+        }
+    }
+
+    AMLValueType getType() const
+    {
+        return m_type;
+    }
+
+    // Getters below have to be called with the value of the same type.
+    const std::string& getString() const
+    {
+        return m_string;
+    }
+
+    const std::vector<std::string>& getStringArray() const
+    {
+        return m_stringArray;
+    }
+
+    std::string& getString()
+    {
+        return m_string;
+    }
+
+    std::vector<std::string>& getStringArray()
+    {
+        return m_stringArray;
+    }
+
+    const AMLData& getData() const
+    {
+        return m_data;
+    }
+
+    AMLData& getData()
+    {
+        return m_data;
+    }
+
 private:
-    T m_value;
+    AMLValueType m_type;
+    union
+    {
+        std::string                 m_string;
+        std::vector<std::string>    m_stringArray;
+        AMLData                     m_data;
+    };
 };
 
 } // namespace AML
 
-#endif // AML_VALUE_H_
\ No newline at end of file
+#endif // AML_VALUE_H_
@@ -0,0 +1,118 @@
+/*******************************************************************************
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *******************************************************************************/
+
+#ifndef AML_WRITER_H_
+#define AML_WRITER_H_
+
+#include <string>
+
+namespace AML
+{
+
+/**
+ * @class AMLWriter
+ * @brief This class writes XML text directly into a string buffer.
+ *        The output is formatted exactly as pugixml does with its default options
+ *        (format_indent, "\t"), so it can replace a pugi::xml_document::save() call byte for byte.
+ */
+class AMLWriter
+{
+public:
+    /**
+     * @brief       Constructor.
+     * @param       out     [in] String buffer that the XML text is appended to.
+     * @param       depth   [in] Indentation depth of the first element.
+     */
+    AMLWriter(std::string& out, unsigned int depth = 0);
+
+    /**
+     * @fn void declaration()
+     * @brief       This function writes XML declaration, <?xml version="1.0" encoding="utf-8"?>.
+     */
+    void                declaration();
+
+    /**
+     * @fn void startElement(const char* name)
+     * @brief       This function opens a new element. Attributes can be written until any child is added.
+     * @param       name    [in] Element name.
+     */
+    void                startElement(const char* name);
+
+    /**
+     * @fn void attribute(const char* name, const char* value)
+     * @brief       This function writes an attribute of the element opened last.
+     * @param       name    [in] Attribute name.
+     * @param       value   [in] Attribute value. It is escaped.
+     */
+    void                attribute(const char* name, const char* value);
+
+    /**
+     * @fn void text(const char* value)
+     * @brief       This function writes a PCDATA child of the current element.
+     * @param       value   [in] Text value. It is escaped.
+     */
+    void                text(const char* value);
+
+    /**
+     * @fn void cdata(const char* value)
+     * @brief       This function writes a CDATA child of the current element.
+     * @param       value   [in] CDATA value.
+     */
+    void                cdata(const char* value);
+
+    /**
+     * @fn void endElement(const char* name)
+     * @brief       This function closes the current element.
+     * @param       name    [in] Element name which has to be the same as the one of startElement().
+     */
+    void                endElement(const char* name);
+
+    /**
+     * @fn void beginChildren()
+     * @brief       This function closes the start tag of the current element, so that its child elements can be added afterwards
+     *              as text rendered separately. The end tag of the element will be written on a new line.
+     */
+    void                beginChildren();
+
+    /**
+     * @fn void finish()
+     * @brief       This function writes the trailing line feed of a document.
+     */
+    void                finish();
+
+    /**
+     * @fn void escape(std::string& out, const char* value, bool isAttribute)
+     * @brief       This function appends a value escaped as pugixml does.
+     * @param       out         [in] String buffer that the escaped value is appended to.
+     * @param       value       [in] Value to be escaped.
+     * @param       isAttribute [in] true if value is an attribute value, false if it is a PCDATA.
+     */
+    static void         escape(std::string& out, const char* value, bool isAttribute);
+
+private:
+    void                closeStartTag();
+    void                indent();
+
+    std::string&        m_out;
+    unsigned int        m_depth;
+    unsigned int        m_indentFlags;
+    bool                m_startTagOpened;
+};
+
+} // namespace AML
+
+#endif // AML_WRITER_H_
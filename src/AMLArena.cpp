@@ -0,0 +1,111 @@
+/*******************************************************************************
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *******************************************************************************/
+
+#include <stdint.h>
+#include <cstddef>
+#include <new>
+#include <vector>
+
+#include "AMLArena.h"
+
+using namespace std;
+using namespace AML;
+
+// allocations larger than this part of a block use blocks of their own, so that a block is not wasted.
+static const size_t LARGE_ALLOCATION_RATIO = 4;
+
+AMLArena::AMLArena(size_t blockSize)
+ : m_blockSize(blockSize), m_firstBlock(nullptr), m_pos(nullptr), m_end(nullptr), m_size(0)
+{
+}
+
+AMLArena::~AMLArena(void)
+{
+    reset();
+    ::operator delete(m_firstBlock);
+}
+
+char* AMLArena::allocateBlock(size_t size)
+{
+    char* block = static_cast<char*>(::operator new(size));
+    try
+    {
+        m_blocks.push_back(block);
+    }
+    catch (...)
+    {
+        ::operator delete(block);
+        throw;
+    }
+    return block;
+}
+
+void* AMLArena::allocate(size_t size, size_t alignment)
+{
+    uintptr_t pos = (reinterpret_cast<uintptr_t>(m_pos) + alignment - 1) & ~(uintptr_t)(alignment - 1);
+    if (nullptr == m_pos || pos + size > reinterpret_cast<uintptr_t>(m_end))
+    {
+        // memory of ::operator new() is aligned for any type
+        if (size > m_blockSize / LARGE_ALLOCATION_RATIO)
+        {
+            m_size += size;
+            return allocateBlock(size);
+        }
+
+        char* block = nullptr;
+        if (nullptr == m_firstBlock)
+        {
+            block = m_firstBlock = static_cast<char*>(::operator new(m_blockSize));
+        }
+        else
+        {
+            block = allocateBlock(m_blockSize);
+        }
+        m_pos = block;
+        m_end = block + m_blockSize;
+        pos = reinterpret_cast<uintptr_t>(m_pos);
+    }
+
+    m_pos = reinterpret_cast<char*>(pos + size);
+    m_size += size;
+    return reinterpret_cast<void*>(pos);
+}
+
+void AMLArena::reset()
+{
+    while (!m_objects.empty())
+    {
+        std::pair<void*, void (*)(void*)> object = m_objects.back();
+        m_objects.pop_back();
+        object.second(object.first);
+    }
+
+    for (char* block : m_blocks)
+    {
+        ::operator delete(block);
+    }
+    m_blocks.clear();
+
+    m_pos = m_firstBlock;
+    m_end = m_firstBlock ? m_firstBlock + m_blockSize : nullptr;
+    m_size = 0;
+}
+
+size_t AMLArena::size() const
+{
+    return m_size;
+}
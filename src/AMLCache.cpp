@@ -0,0 +1,322 @@
+/*******************************************************************************
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *******************************************************************************/
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "AMLCache.h"
+
+using namespace std;
+using namespace AML;
+
+// XXH64, which hashes 8 bytes at a time in 4 lanes, so that hashing is not slower than reading the content.
+static const uint64_t PRIME64_1 = 11400714785074694791ULL;
+static const uint64_t PRIME64_2 = 14029467366897019727ULL;
+static const uint64_t PRIME64_3 = 1609587929392839161ULL;
+static const uint64_t PRIME64_4 = 9650029242287828579ULL;
+static const uint64_t PRIME64_5 = 2870177450012600261ULL;
+
+static inline uint64_t rotateLeft(uint64_t value, int bits)
+{
+    return (value << bits) | (value >> (64 - bits));
+}
+
+static inline uint64_t readWord64(const char* data)
+{
+    uint64_t value;
+    memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+static inline uint32_t readWord32(const char* data)
+{
+    uint32_t value;
+    memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+static inline uint64_t round64(uint64_t acc, uint64_t input)
+{
+    acc += input * PRIME64_2;
+    return rotateLeft(acc, 31) * PRIME64_1;
+}
+
+static inline uint64_t mergeRound64(uint64_t acc, uint64_t value)
+{
+    acc ^= round64(0, value);
+    return acc * PRIME64_1 + PRIME64_4;
+}
+
+uint64_t AML::hashContent(const char* data, size_t size)
+{
+    const char* pos = data;
+    const char* end = data + size;
+    uint64_t hash;
+
+    if (size >= 32)
+    {
+        uint64_t v1 = PRIME64_1 + PRIME64_2;
+        uint64_t v2 = PRIME64_2;
+        uint64_t v3 = 0;
+        uint64_t v4 = 0 - PRIME64_1;
+
+        for (; pos + 32 <= end; pos += 32)
+        {
+            v1 = round64(v1, readWord64(pos));
+            v2 = round64(v2, readWord64(pos + 8));
+            v3 = round64(v3, readWord64(pos + 16));
+            v4 = round64(v4, readWord64(pos + 24));
+        }
+
+        hash = rotateLeft(v1, 1) + rotateLeft(v2, 7) + rotateLeft(v3, 12) + rotateLeft(v4, 18);
+        hash = mergeRound64(hash, v1);
+        hash = mergeRound64(hash, v2);
+        hash = mergeRound64(hash, v3);
+        hash = mergeRound64(hash, v4);
+    }
+    else
+    {
+        hash = PRIME64_5;
+    }
+
+    hash += static_cast<uint64_t>(size);
+
+    for (; pos + 8 <= end; pos += 8)
+    {
+        hash ^= round64(0, readWord64(pos));
+        hash = rotateLeft(hash, 27) * PRIME64_1 + PRIME64_4;
+    }
+    if (pos + 4 <= end)
+    {
+        hash ^= static_cast<uint64_t>(readWord32(pos)) * PRIME64_1;
+        hash = rotateLeft(hash, 23) * PRIME64_2 + PRIME64_3;
+        pos += 4;
+    }
+    for (; pos < end; ++pos)
+    {
+        hash ^= static_cast<uint64_t>(static_cast<unsigned char>(*pos)) * PRIME64_5;
+        hash = rotateLeft(hash, 11) * PRIME64_1;
+    }
+
+    hash ^= hash >> 33;
+    hash *= PRIME64_2;
+    hash ^= hash >> 29;
+    hash *= PRIME64_3;
+    hash ^= hash >> 32;
+
+    return hash;
+}
+
+AMLCacheWriter::AMLCacheWriter(std::string& out) : m_out(out)
+{
+}
+
+void AMLCacheWriter::writeU8(uint8_t value)
+{
+    m_out.push_back(static_cast<char>(value));
+}
+
+void AMLCacheWriter::writeU32(uint32_t value)
+{
+    for (int i = 0; i < 4; ++i)
+    {
+        m_out.push_back(static_cast<char>((value >> (i * 8)) & 0xff));
+    }
+}
+
+void AMLCacheWriter::writeU64(uint64_t value)
+{
+    for (int i = 0; i < 8; ++i)
+    {
+        m_out.push_back(static_cast<char>((value >> (i * 8)) & 0xff));
+    }
+}
+
+void AMLCacheWriter::writeString(const std::string& value)
+{
+    writeString(value.data(), value.size());
+}
+
+void AMLCacheWriter::writeString(const char* data, size_t size)
+{
+    writeU64(size);
+    m_out.append(data, size);
+}
+
+AMLCacheReader::AMLCacheReader(const char* begin, const char* end) : m_pos(begin), m_end(end)
+{
+}
+
+bool AMLCacheReader::readUnsigned(size_t size, uint64_t& value)
+{
+    if (static_cast<size_t>(m_end - m_pos) < size)
+    {
+        return false;
+    }
+
+    value = 0;
+    for (size_t i = 0; i < size; ++i)
+    {
+        value |= static_cast<uint64_t>(static_cast<unsigned char>(m_pos[i])) << (i * 8);
+    }
+    m_pos += size;
+    return true;
+}
+
+bool AMLCacheReader::readU8(uint8_t& value)
+{
+    uint64_t v;
+    if (!readUnsigned(1, v))
+    {
+        return false;
+    }
+    value = static_cast<uint8_t>(v);
+    return true;
+}
+
+bool AMLCacheReader::readU32(uint32_t& value)
+{
+    uint64_t v;
+    if (!readUnsigned(4, v))
+    {
+        return false;
+    }
+    value = static_cast<uint32_t>(v);
+    return true;
+}
+
+bool AMLCacheReader::readU64(uint64_t& value)
+{
+    return readUnsigned(8, value);
+}
+
+bool AMLCacheReader::readString(std::string& value)
+{
+    const char* data;
+    size_t size;
+    if (!readString(data, size))
+    {
+        return false;
+    }
+    value.assign(data, size);
+    return true;
+}
+
+bool AMLCacheReader::readString(const char*& data, size_t& size)
+{
+    uint64_t length;
+    if (!readU64(length) || length > static_cast<uint64_t>(m_end - m_pos))
+    {
+        return false;
+    }
+    size = static_cast<size_t>(length);
+    return readBytes(size, data);
+}
+
+bool AMLCacheReader::readBytes(size_t size, const char*& data)
+{
+    if (static_cast<size_t>(m_end - m_pos) < size)
+    {
+        return false;
+    }
+    data = m_pos;
+    m_pos += size;
+    return true;
+}
+
+bool AMLCacheReader::atEnd() const
+{
+    return m_pos == m_end;
+}
+
+AMLMappedFile::AMLMappedFile(void) : m_data(nullptr), m_size(0), m_mapped(false)
+{
+}
+
+AMLMappedFile::~AMLMappedFile(void)
+{
+    close();
+}
+
+bool AMLMappedFile::open(const std::string& filePath)
+{
+    close();
+
+#ifndef _WIN32
+    int fd = ::open(filePath.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    struct stat st;
+    if (0 != fstat(fd, &st) || 0 == st.st_size)
+    {
+        ::close(fd);
+        return false;
+    }
+
+    void* data = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (MAP_FAILED == data)
+    {
+        return false;
+    }
+
+    m_data = static_cast<const char*>(data);
+    m_size = static_cast<size_t>(st.st_size);
+    m_mapped = true;
+    return true;
+#else
+    ifstream file(filePath, ios::binary);
+    if (!file)
+    {
+        return false;
+    }
+
+    stringstream buffer;
+    buffer << file.rdbuf();
+    m_buffer = buffer.str();
+    m_data = m_buffer.data();
+    m_size = m_buffer.size();
+    return true;
+#endif
+}
+
+void AMLMappedFile::close()
+{
+#ifndef _WIN32
+    if (m_mapped)
+    {
+        munmap(const_cast<char*>(m_data), m_size);
+    }
+#endif
+    m_buffer.clear();
+    m_data = nullptr;
+    m_size = 0;
+    m_mapped = false;
+}
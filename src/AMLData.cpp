@@ -17,10 +17,16 @@
 
 #include <string>
 #include <vector>
-#include <map>
+#include <algorithm>
+#include <utility>
+#include <tuple>
+#include <memory>
 
 #include "AMLInterface.h"
 #include "AMLValue.h"
+#include "AMLShared.h"
+#include "AMLKeyTable.h"
+#include "AMLArenaAllocator.h"
 #include "AMLException.h"
 #include "AMLLogger.h"
 
@@ -35,29 +41,367 @@ using namespace std;
 using namespace AML;
 
 
+/*
+ * Values are shared by copies of AMLData and they are copied when one of the copies is modified.
+ * Shared values are never modified, so that they can be read from multiple threads at the same time.
+ */
+struct AMLData::Values
+{
+    std::shared_ptr<const AMLKeyTable> keyTable;             // keys of a model, which are kept as ids less than tableSize
+    unsigned int tableSize;                                  // size of keyTable, or 0 without keyTable
+    AMLArenaVector<std::string> ownKeys;                        // other keys, which are kept as ids from tableSize
+    AMLArenaVector<std::pair<unsigned int, AMLValue>> values;  // key id and value in order of setValue()
+    AMLArenaVector<unsigned int> sortedIndex;                   // indices of values sorted by key
+    AMLArenaVector<AMLValue> spare;                             // values removed by clear() in reverse order, to be reused
+    AMLArena* arena;                                         // arena of this and the vectors, or null on the heap
+
+    static const unsigned int NO_ID = (unsigned int)-1;
+
+    // value of emplaceData(), which is an empty AMLData with the same key table and arena
+    struct EmptyData
+    {
+    };
+
+    explicit Values(const std::shared_ptr<const AMLKeyTable>& table = nullptr, AMLArena* valueArena = nullptr)
+     : keyTable(table), tableSize(table ? table->size() : 0), ownKeys(AMLArenaAllocator<std::string>(valueArena)),
+       values(AMLArenaAllocator<std::pair<unsigned int, AMLValue>>(valueArena)),
+       sortedIndex(AMLArenaAllocator<unsigned int>(valueArena)), spare(AMLArenaAllocator<AMLValue>(valueArena)), arena(valueArena)
+    {
+        // most of AMLData have a few values
+        values.reserve(4);
+        sortedIndex.reserve(4);
+    }
+
+    // the copy is on the heap, as the vectors are.
+    Values(const Values& t)
+     : keyTable(t.keyTable), tableSize(t.tableSize), ownKeys(t.ownKeys), values(t.values), sortedIndex(t.sortedIndex), arena(nullptr)
+    {
+    }
+
+    static std::shared_ptr<Values> create(const std::shared_ptr<const AMLKeyTable>& keyTable, AMLArena* arena)
+    {
+        if (nullptr == arena)
+        {
+            return std::make_shared<Values>(keyTable);
+        }
+        return std::allocate_shared<Values>(AMLArenaAllocator<Values>(arena), keyTable, arena);
+    }
+
+    // values in an arena are not shared, so that copies can be used after the arena is reset.
+    static std::shared_ptr<Values> share(const std::shared_ptr<Values>& t)
+    {
+        if (t && nullptr != t->arena)
+        {
+            return std::make_shared<Values>(*t);
+        }
+        return t;
+    }
+
+    // moved values in an arena are copied as share() does, so that the moved AMLData can be used after the arena is reset.
+    // The others are taken over as they are.
+    static std::shared_ptr<Values> take(std::shared_ptr<Values>&& t)
+    {
+        if (t && nullptr != t->arena)
+        {
+            std::shared_ptr<Values> copy = std::make_shared<Values>(*t);
+            t.reset();
+            return copy;
+        }
+        return std::move(t);
+    }
+
+    const std::string& key(unsigned int id) const
+    {
+        return id < tableSize ? keyTable->key(id) : ownKeys[id - tableSize];
+    }
+
+    // returns the id of key in keyTable, or NO_ID
+    unsigned int findId(const std::string& key) const
+    {
+        unsigned int id = NO_ID;
+        if (0 == tableSize || !keyTable->find(key, id))
+        {
+            return NO_ID;
+        }
+        return id;
+    }
+
+    // ids of keyTable are in the order of keys, so they are compared instead of keys.
+    AMLArenaVector<unsigned int>::const_iterator lowerBound(const std::string& key, unsigned int id) const
+    {
+        if (NO_ID == id)
+        {
+            return std::lower_bound(sortedIndex.begin(), sortedIndex.end(), key,
+                                    [this](unsigned int index, const std::string& k) { return this->key(values[index].first) < k; });
+        }
+        return std::lower_bound(sortedIndex.begin(), sortedIndex.end(), key,
+                                [this, id](unsigned int index, const std::string& k)
+                                {
+                                    unsigned int valueId = values[index].first;
+                                    return valueId < tableSize ? valueId < id : ownKeys[valueId - tableSize] < k;
+                                });
+    }
+
+    bool isKey(AMLArenaVector<unsigned int>::const_iterator iter, const std::string& key, unsigned int id) const
+    {
+        if (iter == sortedIndex.end())
+        {
+            return false;
+        }
+
+        unsigned int valueId = values[*iter].first;
+        return (NO_ID != id && valueId < tableSize) ? valueId == id : this->key(valueId) == key;
+    }
+
+    // values are moved to spare in reverse order, so that they are taken from the back in order of setValue().
+    void clear()
+    {
+        spare.clear();
+        spare.reserve(values.size());
+        for (auto iter = values.rbegin(); iter != values.rend(); ++iter)
+        {
+            spare.push_back(std::move(iter->second));
+        }
+
+        values.clear();
+        sortedIndex.clear();
+        ownKeys.clear();
+    }
+
+    // The next value removed by clear() is reused if it has the same type,
+    // so that decoding the same schema again keeps the capacity of strings and vectors.
+    template <typename T>
+    AMLValue newValue(T&& value)
+    {
+        if (!spare.empty())
+        {
+            AMLValue reused(std::move(spare.back()));
+            spare.pop_back();
+            if (assign(reused, std::forward<T>(value)))
+            {
+                return reused;
+            }
+        }
+        return AMLValue(std::forward<T>(value));
+    }
+
+    AMLValue newValue(EmptyData)
+    {
+        if (!spare.empty())
+        {
+            AMLValue reused(std::move(spare.back()));
+            spare.pop_back();
+            if (AMLValueType::AMLData == reused.getType())
+            {
+                AMLData& data = reused.getData();
+                if (data.m_values)  data.clear();
+                else                data = emptyData();
+                return reused;
+            }
+        }
+        return AMLValue(emptyData());
+    }
+
+    AMLData emptyData() const
+    {
+        return (keyTable || arena) ? AMLData(keyTable, arena) : AMLData();
+    }
+
+    static bool assign(AMLValue& target, const std::string& value)
+    {
+        if (AMLValueType::String != target.getType())
+        {
+            return false;
+        }
+        target.getString() = value;
+        return true;
+    }
+
+    static bool assign(AMLValue& target, std::string&& value)
+    {
+        if (AMLValueType::String != target.getType())
+        {
+            return false;
+        }
+        target.getString() = std::move(value);
+        return true;
+    }
+
+    static bool assign(AMLValue& target, const std::vector<std::string>& value)
+    {
+        if (AMLValueType::StringArray != target.getType())
+        {
+            return false;
+        }
+        target.getStringArray() = value;
+        return true;
+    }
+
+    static bool assign(AMLValue& target, std::vector<std::string>&& value)
+    {
+        if (AMLValueType::StringArray != target.getType())
+        {
+            return false;
+        }
+        target.getStringArray() = std::move(value);
+        return true;
+    }
+
+    static bool assign(AMLValue& target, const AMLValue& value)
+    {
+        switch (value.getType())
+        {
+            case AMLValueType::String:      return assign(target, value.getString());
+            case AMLValueType::StringArray: return assign(target, value.getStringArray());
+            default:                        return false;
+        }
+    }
+
+    // AMLData and moved AMLValue replace the storage of the value anyway.
+    static bool assign(AMLValue&, const AMLData&)
+    {
+        return false;
+    }
+
+    static bool assign(AMLValue&, AMLValue&&)
+    {
+        return false;
+    }
+};
+
 AMLData::AMLData(void)
 {
 }
 
-AMLData::AMLData(const AMLData& t) 
+AMLData::AMLData(const std::shared_ptr<const AMLKeyTable>& keyTable, AMLArena* arena) : m_values(Values::create(keyTable, arena))
+{
+}
+
+AMLData::AMLData(const AMLData& t) : m_values(Values::share(t.m_values))
 {
-    t.copyData(this);
 }
 
 AMLData& AMLData::operator=(const AMLData& t)
 {
-    t.copyData(this);
+    if (&t != this && (!m_values || m_values->values.empty()))
+    {
+        m_values = Values::share(t.m_values);
+    }
+    else
+    {
+        t.copyData(this);
+    }
+    return *this;
+}
+
+AMLData::AMLData(AMLData&& t) noexcept : m_values(Values::take(std::move(t.m_values)))
+{
+}
+
+AMLData& AMLData::operator=(AMLData&& t)
+{
+    if (&t == this)
+    {
+        return *this;
+    }
+
+    if (!m_values || m_values->values.empty())
+    {
+        m_values = Values::take(std::move(t.m_values));
+    }
+    else if (t.m_values && isUnique(t.m_values) && nullptr == t.m_values->arena)
+    {
+        // same as copy assignment, values are added to this AMLData.
+        for (unsigned int index : t.m_values->sortedIndex)
+        {
+            insertValue(t.m_values->key(t.m_values->values[index].first), std::move(t.m_values->values[index].second));
+        }
+    }
+    else
+    {
+        t.copyData(this);
+    }
+    t.m_values.reset();
     return *this;
 }
 
 AMLData::~AMLData(void)
 {
-    if (!m_values.empty()) 
+}
+
+void AMLData::relocate(AMLData& t) noexcept
+{
+    m_values = std::move(t.m_values);
+}
+
+const AMLValue* AMLData::findValue(const std::string& key) const
+{
+    if (!m_values)
+    {
+        return nullptr;
+    }
+
+    unsigned int id = m_values->findId(key);
+    auto iter = m_values->lowerBound(key, id);
+    if (m_values->isKey(iter, key, id))
     {
-        for (auto const& iter : m_values)
+        return &m_values->values[*iter].second;
+    }
+    return nullptr;
+}
+
+AMLData::Values& AMLData::mutableValues()
+{
+    if (!m_values)
+    {
+        m_values = std::make_shared<Values>();
+    }
+    else if (!isUnique(m_values))
+    {
+        m_values = std::make_shared<Values>(*m_values);
+    }
+    return *m_values;
+}
+
+template <typename T>
+void AMLData::insertValue(const std::string& key, T&& value)
+{
+    size_t pos = 0;
+    unsigned int id = Values::NO_ID;
+    if (m_values)
+    {
+        id = m_values->findId(key);
+        auto iter = m_values->lowerBound(key, id);
+        if (m_values->isKey(iter, key, id))
         {
-            delete iter.second;
+            AML_LOG_V(ERROR, TAG, "Key already exist in AMLData : %s", key.c_str());
+            throw AMLException(KEY_ALREADY_EXIST);
         }
+        pos = iter - m_values->sortedIndex.begin();
+    }
+
+    // the copy of shared values has the same index, so pos is still valid.
+    Values& values = mutableValues();
+
+    if (Values::NO_ID == id)
+    {
+        id = values.tableSize + (unsigned int)values.ownKeys.size();
+        values.ownKeys.push_back(key);
+    }
+
+    values.sortedIndex.insert(values.sortedIndex.begin() + pos, (unsigned int)values.values.size());
+    try
+    {
+        values.values.emplace_back(std::piecewise_construct, std::forward_as_tuple(id), std::forward_as_tuple(values.newValue(std::forward<T>(value))));
+    }
+    catch (...)
+    {
+        values.sortedIndex.erase(values.sortedIndex.begin() + pos);
+        if (values.tableSize <= id)
+        {
+            values.ownKeys.pop_back();
+        }
+        throw;
     }
 }
 
@@ -66,13 +410,7 @@ void AMLData::setValue(const std::string& key, const std::string& value)
     VERIFY_NON_EMPTY_THROW_EXCEPTION(key);
     VERIFY_NON_EMPTY_THROW_EXCEPTION(value);
 
-    if (m_values.find(key) != m_values.end())
-    {
-        AML_LOG_V(ERROR, TAG, "Key already exist in AMLData : %s", key.c_str());
-        throw AMLException(KEY_ALREADY_EXIST);
-    }
-
-    m_values[key] = (AMLValue*) new AMLValue_<std::string>(AMLValueType::String, value);
+    insertValue(key, value);
 }
 
 void AMLData::setValue(const std::string& key, const std::vector<std::string>& value)
@@ -80,34 +418,78 @@ void AMLData::setValue(const std::string& key, const std::vector<std::string>& v
     VERIFY_NON_EMPTY_THROW_EXCEPTION(key);
     VERIFY_NON_EMPTY_THROW_EXCEPTION(value);
 
-    if (m_values.find(key) != m_values.end())
-    {
-        AML_LOG_V(ERROR, TAG, "Key already exist in AMLData : %s", key.c_str());
-        throw AMLException(KEY_ALREADY_EXIST);
-    }
-
-    m_values[key] = (AMLValue*) new AMLValue_<std::vector<std::string>>(AMLValueType::StringArray, value);
+    insertValue(key, value);
 }
 
 void AMLData::setValue(const std::string& key, const AMLData& value)
 {
     VERIFY_NON_EMPTY_THROW_EXCEPTION(key);
 
-    if (m_values.find(key) != m_values.end())
+    // value is shared before this AMLData is modified, in case value is this AMLData.
+    insertValue(key, AMLData(value));
+}
+
+void AMLData::setValue(const std::string& key, std::string&& value)
+{
+    VERIFY_NON_EMPTY_THROW_EXCEPTION(key);
+    VERIFY_NON_EMPTY_THROW_EXCEPTION(value);
+
+    insertValue(key, std::move(value));
+}
+
+void AMLData::setValue(const std::string& key, std::vector<std::string>&& value)
+{
+    VERIFY_NON_EMPTY_THROW_EXCEPTION(key);
+    VERIFY_NON_EMPTY_THROW_EXCEPTION(value);
+
+    insertValue(key, std::move(value));
+}
+
+void AMLData::setValue(const std::string& key, AMLData&& value)
+{
+    VERIFY_NON_EMPTY_THROW_EXCEPTION(key);
+
+    insertValue(key, std::move(value));
+}
+
+AMLData& AMLData::emplaceData(const std::string& key)
+{
+    VERIFY_NON_EMPTY_THROW_EXCEPTION(key);
+
+    // the child uses the same key table and arena.
+    insertValue(key, Values::EmptyData());
+    return m_values->values.back().second.getData();
+}
+
+void AMLData::clear()
+{
+    if (!m_values)
+    {
+        return;
+    }
+
+    if (!isUnique(m_values))
     {
-        AML_LOG_V(ERROR, TAG, "Key already exist in AMLData : %s", key.c_str());
-        throw AMLException(KEY_ALREADY_EXIST);
+        // the values are kept by the copies.
+        m_values = Values::create(m_values->keyTable, m_values->arena);
+        return;
     }
-    
-    m_values[key] = (AMLValue*) new AMLValue_<AMLData>(AMLValueType::AMLData, value);
+
+    m_values->clear();
 }
 
 std::vector<std::string> AMLData::getKeys() const
 {
     std::vector<std::string> keys;
-    for (auto const& element : m_values)
+    if (!m_values)
+    {
+        return keys;
+    }
+
+    keys.reserve(m_values->sortedIndex.size());
+    for (unsigned int index : m_values->sortedIndex)
     {
-        keys.push_back(element.first);
+        keys.push_back(m_values->key(m_values->values[index].first));
     }
 
     return keys;
@@ -117,96 +499,84 @@ AMLValueType AMLData::getValueType(const std::string& key) const
 {
     VERIFY_NON_EMPTY_THROW_EXCEPTION(key);
 
-    for (auto const& element : m_values)
+    const AMLValue* value = findValue(key);
+    if (nullptr == value)
     {
-        if (key.compare(element.first) == 0)
-        {
-            AMLValueType type = element.second->getType();
-
-            return type;
-        }
+        AML_LOG_V(ERROR, TAG, "Key does not exist in AMLData : %s", key.c_str());
+        throw AMLException(KEY_NOT_EXIST);
     }
 
-    AML_LOG_V(ERROR, TAG, "Key does not exist in AMLData : %s", key.c_str());
-    throw AMLException(KEY_NOT_EXIST);
+    return value->getType();
 }
 
 const std::string& AMLData::getValueToStr(const std::string& key) const
 {
     VERIFY_NON_EMPTY_THROW_EXCEPTION(key);
 
-    auto iter = m_values.find(key);
-    if (iter == m_values.end())
+    const AMLValue* value = findValue(key);
+    if (nullptr == value)
     {
         AML_LOG_V(ERROR, TAG, "Key does not exist in AMLData : %s", key.c_str());
         throw AMLException(KEY_NOT_EXIST);
     }
-    else if (AMLValueType::String != iter->second->getType())
+    else if (AMLValueType::String != value->getType())
     {
-        AML_LOG_V(ERROR, TAG, "'%s' has a value of %s type", key.c_str(), TYPE(iter->second->getType()));
+        AML_LOG_V(ERROR, TAG, "'%s' has a value of %s type", key.c_str(), TYPE(value->getType()));
         throw AMLException(WRONG_GETTER_TYPE);
     }
 
-    return ((AMLValue_<std::string>*)iter->second)->getValue();
+    return value->getString();
 }
 
 const std::vector<std::string>& AMLData::getValueToStrArr(const std::string& key) const
 {
     VERIFY_NON_EMPTY_THROW_EXCEPTION(key);
 
-    auto iter = m_values.find(key);
-    if (iter == m_values.end())
+    const AMLValue* value = findValue(key);
+    if (nullptr == value)
     {
         AML_LOG_V(ERROR, TAG, "Key does not exist in AMLData : %s", key.c_str());
         throw AMLException(KEY_NOT_EXIST);
     }
-    else if (AMLValueType::StringArray != iter->second->getType())
+    else if (AMLValueType::StringArray != value->getType())
     {
-        AML_LOG_V(ERROR, TAG, "'%s' has a value of %s type", key.c_str(), TYPE(iter->second->getType()));
+        AML_LOG_V(ERROR, TAG, "'%s' has a value of %s type", key.c_str(), TYPE(value->getType()));
         throw AMLException(WRONG_GETTER_TYPE);
     }
 
-    AMLValue_<std::vector<std::string>>* amlVal = (AMLValue_<std::vector<std::string>>*)iter->second;
-    return amlVal->getValue();
+    return value->getStringArray();
 }
 
 const AMLData& AMLData::getValueToAMLData(const std::string& key) const
 {
     VERIFY_NON_EMPTY_THROW_EXCEPTION(key);
 
-    auto iter = m_values.find(key);
-    if (iter == m_values.end())
+    const AMLValue* value = findValue(key);
+    if (nullptr == value)
     {
         AML_LOG_V(ERROR, TAG, "Key does not exist in AMLData : %s", key.c_str());
         throw AMLException(KEY_NOT_EXIST);
     }
-    else if (AMLValueType::AMLData != iter->second->getType())
+    else if (AMLValueType::AMLData != value->getType())
     {
-        AML_LOG_V(ERROR, TAG, "'%s' has a value of %s type", key.c_str(), TYPE(iter->second->getType()));
+        AML_LOG_V(ERROR, TAG, "'%s' has a value of %s type", key.c_str(), TYPE(value->getType()));
         throw AMLException(WRONG_GETTER_TYPE);
     }
 
-    AMLValue_<AMLData>* amlVal = (AMLValue_<AMLData>*)iter->second;
-    return amlVal->getValue();
+    return value->getData();
 }
 
 void AMLData::copyData(AMLData* target) const
 {
-    for (auto const& element : m_values)
+    if (!m_values)
     {
-        string key(element.first);
+        return;
+    }
 
-        if (AMLValueType::String == element.second->getType())
-        {
-            target->setValue(key, ((AMLValue_<string>*)element.second)->getValue());
-        }
-        else if (AMLValueType::StringArray == element.second->getType())
-        {
-            target->setValue(key, ((AMLValue_<vector<string>>*)element.second)->getValue());
-        }
-        else
-        {
-            target->setValue(key, ((AMLValue_<AMLData>*)element.second)->getValue());
-        }
+    // m_values is kept while values are added, in case target is this AMLData.
+    std::shared_ptr<Values> values = m_values;
+    for (unsigned int index : values->sortedIndex)
+    {
+        target->insertValue(values->key(values->values[index].first), values->values[index].second);
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,45 @@
+/*******************************************************************************
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *******************************************************************************/
+
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <utility>
+
+#include "AMLKeyTable.h"
+
+using namespace std;
+using namespace AML;
+
+AMLKeyTable::AMLKeyTable(std::vector<std::string> keys) : m_keys(std::move(keys))
+{
+    std::sort(m_keys.begin(), m_keys.end());
+    m_keys.erase(std::unique(m_keys.begin(), m_keys.end()), m_keys.end());
+    m_keys.shrink_to_fit();
+}
+
+bool AMLKeyTable::find(const std::string& key, unsigned int& id) const
+{
+    auto iter = std::lower_bound(m_keys.begin(), m_keys.end(), key);
+    if (iter == m_keys.end() || *iter != key)
+    {
+        return false;
+    }
+
+    id = (unsigned int)(iter - m_keys.begin());
+    return true;
+}
@@ -17,9 +17,15 @@
 
 #include <string>
 #include <vector>
-#include <map>
+#include <utility>
+#include <algorithm>
+#include <memory>
+#include <new>
 
 #include "AMLInterface.h"
+#include "AMLShared.h"
+#include "AMLArena.h"
+#include "AMLArenaAllocator.h"
 #include "AMLException.h"
 #include "AMLLogger.h"
 
@@ -30,19 +36,152 @@
 using namespace std;
 using namespace AML;
 
+/*
+ * AMLData are kept by pointers, so that references returned by emplaceData() are valid after other AMLData are added.
+ * The list is shared by copies of AMLObject like values of AMLData, except the list in an arena.
+ */
+struct AMLObject::AMLDataList
+{
+    // AMLData in an arena is destroyed without being deleted.
+    struct Deleter
+    {
+        AMLArena* arena;
+
+        void operator()(AMLData* amlData) const
+        {
+            if (nullptr == arena)   delete amlData;
+            else                    amlData->~AMLData();
+        }
+    };
+    typedef std::pair<std::string, std::unique_ptr<AMLData, Deleter>> Element;
+
+    AMLArenaVector<Element> datas;  // sorted by name
+    AMLArenaVector<Element> spare;  // AMLData removed by clear() in reverse order, to be reused
+    AMLArena* arena;                // arena of this and AMLData, or null on the heap
+
+    explicit AMLDataList(AMLArena* dataArena = nullptr)
+     : datas(AMLArenaAllocator<Element>(dataArena)), spare(AMLArenaAllocator<Element>(dataArena)), arena(dataArena)
+    {
+    }
+
+    // the copy is on the heap, and values of AMLData are shared by the copy unless they are in an arena.
+    AMLDataList(const AMLDataList& t) : arena(nullptr)
+    {
+        datas.reserve(t.datas.size() + 1);
+        for (auto const& element : t.datas)
+        {
+            datas.emplace_back(element.first, newData(*element.second));
+        }
+    }
+
+    template <typename T>
+    std::unique_ptr<AMLData, Deleter> newData(T&& data) const
+    {
+        Deleter deleter = { arena };
+        if (nullptr == arena)
+        {
+            return std::unique_ptr<AMLData, Deleter>(new AMLData(std::forward<T>(data)), deleter);
+        }
+        void* memory = arena->allocate(sizeof(AMLData), alignof(AMLData));
+        return std::unique_ptr<AMLData, Deleter>(new (memory) AMLData(std::forward<T>(data)), deleter);
+    }
+
+    // AMLData are moved to spare in reverse order, so that they are taken from the back in order of emplaceData().
+    void clear()
+    {
+        spare.clear();
+        spare.reserve(datas.size());
+        for (auto iter = datas.rbegin(); iter != datas.rend(); ++iter)
+        {
+            spare.push_back(std::move(*iter));
+        }
+        datas.clear();
+    }
+
+    // The next AMLData removed by clear() is reused with its name, so that decoding the same schema again keeps their storage.
+    Element newElement(const std::string& name, const std::shared_ptr<const AMLKeyTable>& keyTable)
+    {
+        if (spare.empty())
+        {
+            return Element(name, newData((keyTable || arena) ? AMLData(keyTable, arena) : AMLData()));
+        }
+
+        Element element(std::move(spare.back()));
+        spare.pop_back();
+        element.first = name;
+        element.second->clear();
+        return element;
+    }
+
+    static std::shared_ptr<AMLDataList> create(AMLArena* arena)
+    {
+        if (nullptr == arena)
+        {
+            return std::make_shared<AMLDataList>();
+        }
+        return std::allocate_shared<AMLDataList>(AMLArenaAllocator<AMLDataList>(arena), arena);
+    }
+
+    // the list in an arena is not shared, so that copies can be used after the arena is reset.
+    static std::shared_ptr<AMLDataList> share(const std::shared_ptr<AMLDataList>& t)
+    {
+        if (t && nullptr != t->arena)
+        {
+            return std::make_shared<AMLDataList>(*t);
+        }
+        return t;
+    }
+
+    // a moved list in an arena is copied as share() does, so that the moved AMLObject can be used after the arena is reset.
+    // The others are taken over as they are.
+    static std::shared_ptr<AMLDataList> take(std::shared_ptr<AMLDataList>&& t)
+    {
+        if (t && nullptr != t->arena)
+        {
+            std::shared_ptr<AMLDataList> copy = std::make_shared<AMLDataList>(*t);
+            t.reset();
+            return copy;
+        }
+        return std::move(t);
+    }
+
+    static bool isLessName(const Element& element, const std::string& name)
+    {
+        return element.first < name;
+    }
+
+    AMLArenaVector<Element>::iterator lowerBound(const std::string& name)
+    {
+        return std::lower_bound(datas.begin(), datas.end(), name, isLessName);
+    }
+
+    AMLArenaVector<Element>::const_iterator lowerBound(const std::string& name) const
+    {
+        return std::lower_bound(datas.begin(), datas.end(), name, isLessName);
+    }
+};
+
 /*
  * "id" is automatically created using "deviceId" and "timeStamp".
  * e.g.) "deviceId" : "Robot", "timeStamp" : "001" -> "id" : "Robot_001"
  */
 AMLObject::AMLObject(const std::string& deviceId, const std::string& timeStamp)
- : m_deviceId(deviceId), m_timeStamp(timeStamp), m_id(deviceId + "_" + timeStamp)
+ : m_deviceId(deviceId), m_timeStamp(timeStamp), m_id(deviceId + "_" + timeStamp), m_arena(nullptr)
 {
     VERIFY_NON_EMPTY_THROW_EXCEPTION(deviceId);
     VERIFY_NON_EMPTY_THROW_EXCEPTION(timeStamp);
 }
 
 AMLObject::AMLObject(const std::string& deviceId, const std::string& timeStamp, const std::string& id)
- : m_deviceId(deviceId), m_timeStamp(timeStamp), m_id(id)
+ : m_deviceId(deviceId), m_timeStamp(timeStamp), m_id(id), m_arena(nullptr)
+{
+    VERIFY_NON_EMPTY_THROW_EXCEPTION(deviceId);
+    VERIFY_NON_EMPTY_THROW_EXCEPTION(timeStamp);
+    VERIFY_NON_EMPTY_THROW_EXCEPTION(id);
+}
+
+AMLObject::AMLObject(const std::string& deviceId, const std::string& timeStamp, const std::string& id, AMLArena* arena)
+ : m_deviceId(deviceId), m_timeStamp(timeStamp), m_id(id), m_arena(arena)
 {
     VERIFY_NON_EMPTY_THROW_EXCEPTION(deviceId);
     VERIFY_NON_EMPTY_THROW_EXCEPTION(timeStamp);
@@ -50,48 +189,146 @@ AMLObject::AMLObject(const std::string& deviceId, const std::string& timeStamp,
 }
 
 AMLObject::AMLObject(const AMLObject& t)
- : m_deviceId(t.getDeviceId()), m_timeStamp(t.getTimeStamp()), m_id(t.getId())
+ : m_deviceId(t.getDeviceId()), m_timeStamp(t.getTimeStamp()), m_id(t.getId()), m_amlDatas(AMLDataList::share(t.m_amlDatas)), m_arena(nullptr)
 {
-    t.copyObject(this);
 }
 
 AMLObject& AMLObject::operator=(const AMLObject& t)
 {
     if (&t != this)
     {
-        const_cast<std::string&>(m_deviceId) = t.getDeviceId();
-        const_cast<std::string&>(m_timeStamp) = t.getTimeStamp();
-        const_cast<std::string&>(m_id) = t.getId();
+        m_deviceId = t.getDeviceId();
+        m_timeStamp = t.getTimeStamp();
+        m_id = t.getId();
 
-        t.copyObject(this);
+        if (!m_amlDatas || m_amlDatas->datas.empty())
+        {
+            m_amlDatas = AMLDataList::share(t.m_amlDatas);
+        }
+        else
+        {
+            t.copyObject(this);
+        }
+    }
+    return *this;
+}
+
+AMLObject::AMLObject(AMLObject&& t) noexcept
+ : m_deviceId(std::move(t.m_deviceId)), m_timeStamp(std::move(t.m_timeStamp)), m_id(std::move(t.m_id)), m_amlDatas(AMLDataList::take(std::move(t.m_amlDatas))), m_arena(nullptr)
+{
+}
+
+AMLObject& AMLObject::operator=(AMLObject&& t)
+{
+    if (&t != this)
+    {
+        m_deviceId = std::move(t.m_deviceId);
+        m_timeStamp = std::move(t.m_timeStamp);
+        m_id = std::move(t.m_id);
+
+        if (!m_amlDatas || m_amlDatas->datas.empty())
+        {
+            m_amlDatas = AMLDataList::take(std::move(t.m_amlDatas));
+        }
+        else if (t.m_amlDatas && isUnique(t.m_amlDatas) && nullptr == t.m_amlDatas->arena)
+        {
+            // same as copy assignment, AMLData are added to this AMLObject.
+            for (auto& element : t.m_amlDatas->datas)
+            {
+                addData(element.first, std::move(*element.second));
+            }
+        }
+        else
+        {
+            t.copyObject(this);
+        }
+        t.m_amlDatas.reset();
     }
     return *this;
 }
 
 AMLObject::~AMLObject(void)
 {
-    if (!m_amlDatas.empty()) 
+}
+
+AMLObject::AMLDataList& AMLObject::mutableDatas()
+{
+    if (!m_amlDatas)
     {
-        for (auto const& iter : m_amlDatas)
+        m_amlDatas = AMLDataList::create(m_arena);
+    }
+    else if (!isUnique(m_amlDatas))
+    {
+        m_amlDatas = std::make_shared<AMLDataList>(*m_amlDatas);
+    }
+    return *m_amlDatas;
+}
+
+void AMLObject::verifyNewName(const std::string& name) const
+{
+    VERIFY_NON_EMPTY_THROW_EXCEPTION(name);
+
+    // m_amlDatas is sorted by name. If the name already exists, throw an exeption.
+    if (m_amlDatas)
+    {
+        auto iter = m_amlDatas->lowerBound(name);
+        if (iter != m_amlDatas->datas.end() && iter->first == name)
         {
-            delete iter.second;
+            AML_LOG_V(ERROR, TAG, "Name already exist in AMLObject : %s", name.c_str());
+            throw AMLException(KEY_ALREADY_EXIST);
         }
     }
 }
 
+template <typename T>
+AMLData& AMLObject::insertData(const std::string& name, T&& data)
+{
+    verifyNewName(name);
+
+    AMLDataList& amlDatas = mutableDatas();
+    auto amlData = amlDatas.newData(std::forward<T>(data));
+    auto iter = amlDatas.datas.emplace(amlDatas.lowerBound(name), name, std::move(amlData));
+    return *iter->second;
+}
+
 void AMLObject::addData(const std::string& name, const AMLData& data)
 {
-    VERIFY_NON_EMPTY_THROW_EXCEPTION(name);
+    insertData(name, data);
+}
+
+void AMLObject::addData(const std::string& name, AMLData&& data)
+{
+    insertData(name, std::move(data));
+}
+
+AMLData& AMLObject::emplaceData(const std::string& name)
+{
+    return emplaceData(name, nullptr);
+}
+
+AMLData& AMLObject::emplaceData(const std::string& name, const std::shared_ptr<const AMLKeyTable>& keyTable)
+{
+    verifyNewName(name);
 
-    AMLData* amlData = new AMLData();
-    *amlData = data;
+    AMLDataList& amlDatas = mutableDatas();
+    auto iter = amlDatas.datas.insert(amlDatas.lowerBound(name), amlDatas.newElement(name, keyTable));
+    return *iter->second;
+}
 
-    //Try to insert a new element into the map and if the key already exists, throw an exeption.
-    std::pair<const std::string, AMLData*> temp = std::make_pair(name, amlData);
-    if (!m_amlDatas.insert(temp).second)
+void AMLObject::reset(const std::string& deviceId, const std::string& timeStamp, const std::string& id)
+{
+    VERIFY_NON_EMPTY_THROW_EXCEPTION(deviceId);
+    VERIFY_NON_EMPTY_THROW_EXCEPTION(timeStamp);
+    VERIFY_NON_EMPTY_THROW_EXCEPTION(id);
+
+    m_deviceId = deviceId;
+    m_timeStamp = timeStamp;
+    m_id = id;
+
+    if (m_amlDatas)
     {
-        AML_LOG_V(ERROR, TAG, "Name already exist in AMLObject : %s", name.c_str());
-        throw AMLException(KEY_ALREADY_EXIST);
+        if (isUnique(m_amlDatas))   m_amlDatas->clear();
+        else                        m_amlDatas.reset();     // the list is kept by the copies.
     }
 }
 
@@ -99,20 +336,30 @@ const AMLData& AMLObject::getData(const std::string& name) const
 {
     VERIFY_NON_EMPTY_THROW_EXCEPTION(name);
 
-    map<string, AMLData*>::iterator iter = m_amlDatas.find(name);
-    if (iter == m_amlDatas.end())
+    if (m_amlDatas)
     {
-        // The name does not exist.
-        AML_LOG_V(ERROR, TAG, "Name does not exist in AMLObject : %s", name.c_str());
-        throw AMLException(KEY_NOT_EXIST);
+        auto iter = m_amlDatas->lowerBound(name);
+        if (iter != m_amlDatas->datas.end() && iter->first == name)
+        {
+            return *iter->second;
+        }
     }
-    return *(iter->second);
+
+    // The name does not exist.
+    AML_LOG_V(ERROR, TAG, "Name does not exist in AMLObject : %s", name.c_str());
+    throw AMLException(KEY_NOT_EXIST);
 }
 
 vector<string> AMLObject::getDataNames() const
 {
     vector<string> dataNames;
-    for (auto const& iter : m_amlDatas)
+    if (!m_amlDatas)
+    {
+        return dataNames;
+    }
+
+    dataNames.reserve(m_amlDatas->datas.size());
+    for (auto const& iter : m_amlDatas->datas)
     {
         dataNames.push_back(iter.first);
     }
@@ -137,10 +384,15 @@ const std::string& AMLObject::getId() const
 
 void AMLObject::copyObject(AMLObject* target) const
 {
-    for (auto const& element : m_amlDatas)
+    if (!m_amlDatas)
     {
-        string key(element.first);
+        return;
+    }
 
-        target->addData(key, *element.second);
+    // m_amlDatas is kept while AMLData are added, in case target is this AMLObject.
+    std::shared_ptr<AMLDataList> amlDatas = m_amlDatas;
+    for (auto const& element : amlDatas->datas)
+    {
+        target->addData(element.first, *element.second);
     }
-}
\ No newline at end of file
+}
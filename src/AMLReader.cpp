@@ -0,0 +1,640 @@
+/*******************************************************************************
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *******************************************************************************/
+
+#include <string.h>
+#include <string>
+#include <vector>
+
+#include "AMLReader.h"
+
+using namespace std;
+using namespace AML;
+
+static const unsigned int MAX_CODE_POINT = 0x10FFFF;
+
+// the same as pugixml's 'ct_space', 'ct_start_symbol' and 'ct_symbol'
+static inline bool isSpace(char ch)
+{
+    return ' ' == ch || '\t' == ch || '\n' == ch || '\r' == ch;
+}
+
+static inline bool isStartSymbol(char ch)
+{
+    unsigned char uch = static_cast<unsigned char>(ch);
+    return 128 <= uch || ('a' <= (uch | ' ') && (uch | ' ') <= 'z') || '_' == ch || ':' == ch;
+}
+
+static inline bool isSymbol(char ch)
+{
+    return isStartSymbol(ch) || ('0' <= ch && ch <= '9') || '-' == ch || '.' == ch;
+}
+
+static inline bool startsWith(const char* pos, const char* end, const char* str)
+{
+    size_t length = strlen(str);
+    return static_cast<size_t>(end - pos) >= length && 0 == memcmp(pos, str, length);
+}
+
+// returns the position of str in [pos, end), or end if not found
+static const char* find(const char* pos, const char* end, const char* str)
+{
+    size_t length = strlen(str);
+    for (; static_cast<size_t>(end - pos) >= length; ++pos)
+    {
+        pos = static_cast<const char*>(memchr(pos, str[0], (end - pos) - length + 1));
+        if (NULL == pos)
+        {
+            break;
+        }
+        if (0 == memcmp(pos, str, length))
+        {
+            return pos;
+        }
+    }
+    return end;
+}
+
+static void appendUtf8(std::string& out, unsigned int ch)
+{
+    if (ch < 0x80)
+    {
+        out.push_back(static_cast<char>(ch));
+    }
+    else if (ch < 0x800)
+    {
+        out.push_back(static_cast<char>(0xC0 | (ch >> 6)));
+        out.push_back(static_cast<char>(0x80 | (ch & 0x3F)));
+    }
+    else if (ch < 0x10000)
+    {
+        out.push_back(static_cast<char>(0xE0 | (ch >> 12)));
+        out.push_back(static_cast<char>(0x80 | ((ch >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (ch & 0x3F)));
+    }
+    else
+    {
+        out.push_back(static_cast<char>(0xF0 | (ch >> 18)));
+        out.push_back(static_cast<char>(0x80 | ((ch >> 12) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | ((ch >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (ch & 0x3F)));
+    }
+}
+
+AMLReader::AMLReader(const char* begin, const char* end)
+{
+    reset(begin, end);
+}
+
+void AMLReader::reset(const char* begin, const char* end)
+{
+    m_pos = begin;
+    m_end = end;
+    m_token = Token::StartElement;
+    m_attributes.clear();
+    m_openElements.clear();
+    m_emptyElement = false;
+    m_hasRoot = false;
+
+    m_name.begin = m_name.end = begin;
+    m_text.begin = m_text.end = begin;
+
+    // pugixml stops at a null character, and guesses UTF-16/32 from the first bytes.
+    if (begin != end && ('\xFE' == *begin || '\xFF' == *begin || NULL != memchr(begin, 0, end - begin)))
+    {
+        unsupported();
+    }
+
+    // skip UTF-8 BOM
+    if (startsWith(m_pos, m_end, "\xEF\xBB\xBF"))
+    {
+        m_pos += 3;
+    }
+}
+
+AMLReader::Token AMLReader::next()
+{
+    if (Token::Unsupported == m_token)
+    {
+        return m_token;
+    }
+
+    if (m_emptyElement)
+    {
+        m_emptyElement = false;
+        m_openElements.pop_back();
+        return m_token = Token::EndElement;
+    }
+
+    while (m_pos != m_end)
+    {
+        if ('<' != *m_pos)
+        {
+            if (readText())
+            {
+                return m_token;
+            }
+            continue;
+        }
+
+        if (m_end - m_pos < 2)
+        {
+            return unsupported();
+        }
+
+        char ch = m_pos[1];
+        if ('/' == ch)
+        {
+            return readEndTag();
+        }
+        else if ('!' == ch || '?' == ch)
+        {
+            if (readMarkup())
+            {
+                return m_token;
+            }
+        }
+        else if (isStartSymbol(ch))
+        {
+            return readStartTag();
+        }
+        else
+        {
+            return unsupported();
+        }
+    }
+
+    if (!m_openElements.empty() || !m_hasRoot)
+    {
+        return unsupported();
+    }
+    return m_token = Token::EndOfDocument;
+}
+
+bool AMLReader::skipElement()
+{
+    size_t depth = m_openElements.size();
+
+    for (;;)
+    {
+        switch (next())
+        {
+            case Token::EndElement:
+                if (m_openElements.size() < depth)
+                {
+                    return true;
+                }
+                break;
+            case Token::EndOfDocument:
+            case Token::Unsupported:
+                return false;
+            default:
+                break;
+        }
+    }
+}
+
+bool AMLReader::isName(const char* name) const
+{
+    return equals(m_name, name);
+}
+
+bool AMLReader::attribute(const char* name, std::string& value) const
+{
+    for (const Attribute& attr : m_attributes)
+    {
+        if (equals(attr.name, name))
+        {
+            decode(value, attr.value.begin, attr.value.end, true, true);
+            return true;
+        }
+    }
+
+    value.clear();
+    return false;
+}
+
+bool AMLReader::hasAttribute(const char* name, const char* value) const
+{
+    std::string decoded;
+    for (const Attribute& attr : m_attributes)
+    {
+        if (equals(attr.name, name))
+        {
+            decode(decoded, attr.value.begin, attr.value.end, true, true);
+            if (decoded == value)
+            {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void AMLReader::text(std::string& value) const
+{
+    decode(value, m_text.begin, m_text.end, false, Token::Text == m_token);
+}
+
+AMLReader::Token AMLReader::unsupported()
+{
+    m_pos = m_end;
+    return m_token = Token::Unsupported;
+}
+
+AMLReader::Token AMLReader::readStartTag()
+{
+    // only one root element is handled
+    if (m_openElements.empty())
+    {
+        if (m_hasRoot)
+        {
+            return unsupported();
+        }
+        m_hasRoot = true;
+    }
+
+    const char* pos = m_pos + 1;
+
+    m_name.begin = pos;
+    while (pos != m_end && isSymbol(*pos))
+    {
+        ++pos;
+    }
+    m_name.end = pos;
+
+    m_attributes.clear();
+
+    for (;;)
+    {
+        const char* tagEnd = pos;
+        while (pos != m_end && isSpace(*pos))
+        {
+            ++pos;
+        }
+        if (pos == m_end)
+        {
+            return unsupported();
+        }
+
+        if ('>' == *pos)
+        {
+            m_pos = pos + 1;
+            break;
+        }
+        else if ('/' == *pos)
+        {
+            if (pos + 1 == m_end || '>' != pos[1])
+            {
+                return unsupported();
+            }
+            m_pos = pos + 2;
+            m_emptyElement = true;
+            break;
+        }
+        else if (tagEnd == pos || !isStartSymbol(*pos)) // attributes are separated by spaces
+        {
+            return unsupported();
+        }
+
+        Attribute attr;
+
+        attr.name.begin = pos;
+        while (pos != m_end && isSymbol(*pos))
+        {
+            ++pos;
+        }
+        attr.name.end = pos;
+
+        while (pos != m_end && isSpace(*pos))
+        {
+            ++pos;
+        }
+        if (pos == m_end || '=' != *pos)
+        {
+            return unsupported();
+        }
+        ++pos;
+        while (pos != m_end && isSpace(*pos))
+        {
+            ++pos;
+        }
+        if (pos == m_end || ('"' != *pos && '\'' != *pos))
+        {
+            return unsupported();
+        }
+
+        char quote = *pos++;
+
+        attr.value.begin = pos;
+        while (pos != m_end && quote != *pos)
+        {
+            if ('&' == *pos)
+            {
+                if (!scanEscape(pos, m_end))
+                {
+                    return unsupported();
+                }
+            }
+            else if ('<' == *pos)
+            {
+                return unsupported();
+            }
+            else
+            {
+                ++pos;
+            }
+        }
+        if (pos == m_end)
+        {
+            return unsupported();
+        }
+        attr.value.end = pos++;
+
+        m_attributes.push_back(attr);
+    }
+
+    m_openElements.push_back(m_name);
+    return m_token = Token::StartElement;
+}
+
+AMLReader::Token AMLReader::readEndTag()
+{
+    if (m_openElements.empty())
+    {
+        return unsupported();
+    }
+
+    const char* pos = m_pos + 2;
+
+    m_name.begin = pos;
+    while (pos != m_end && isSymbol(*pos))
+    {
+        ++pos;
+    }
+    m_name.end = pos;
+
+    const Span& openName = m_openElements.back();
+    if (m_name.end - m_name.begin != openName.end - openName.begin ||
+        0 != memcmp(m_name.begin, openName.begin, m_name.end - m_name.begin))
+    {
+        return unsupported();
+    }
+
+    while (pos != m_end && isSpace(*pos))
+    {
+        ++pos;
+    }
+    if (pos == m_end || '>' != *pos)
+    {
+        return unsupported();
+    }
+
+    m_pos = pos + 1;
+    m_openElements.pop_back();
+    return m_token = Token::EndElement;
+}
+
+bool AMLReader::readText()
+{
+    const char* pos = m_pos;
+    bool isWhitespace = true;
+
+    while (pos != m_end && '<' != *pos)
+    {
+        if ('&' == *pos)
+        {
+            if (!scanEscape(pos, m_end))
+            {
+                unsupported();
+                return true;
+            }
+            isWhitespace = false;
+        }
+        else
+        {
+            isWhitespace = isWhitespace && isSpace(*pos);
+            ++pos;
+        }
+    }
+
+    m_text.begin = m_pos;
+    m_text.end = pos;
+    m_pos = pos;
+
+    // whitespace-only PCDATA is not loaded by pugixml, and text out of the root element is not handled.
+    if (isWhitespace)
+    {
+        return false;
+    }
+    if (m_openElements.empty())
+    {
+        unsupported();
+        return true;
+    }
+
+    m_token = Token::Text;
+    return true;
+}
+
+bool AMLReader::readMarkup()
+{
+    const char* pos = m_pos;
+
+    if (startsWith(pos, m_end, "<!--"))
+    {
+        pos = find(pos + 4, m_end, "-->");
+        if (pos == m_end)
+        {
+            unsupported();
+            return true;
+        }
+        m_pos = pos + 3;
+        return false;
+    }
+    else if (startsWith(pos, m_end, "<![CDATA["))
+    {
+        m_text.begin = pos + 9;
+        m_text.end = find(m_text.begin, m_end, "]]>");
+        if (m_text.end == m_end || m_openElements.empty())
+        {
+            unsupported();
+            return true;
+        }
+        m_pos = m_text.end + 3;
+        m_token = Token::CData;
+        return true;
+    }
+    else if ('?' == pos[1])
+    {
+        // processing instruction and declaration are skipped, and they are handled only out of the root element
+        pos += 2;
+        if (pos == m_end || !isStartSymbol(*pos) || !m_openElements.empty())
+        {
+            unsupported();
+            return true;
+        }
+        while (pos != m_end && isSymbol(*pos))
+        {
+            ++pos;
+        }
+        pos = find(pos, m_end, "?>");
+        if (pos == m_end)
+        {
+            unsupported();
+            return true;
+        }
+        m_pos = pos + 2;
+        return false;
+    }
+
+    // DOCTYPE is not handled
+    unsupported();
+    return true;
+}
+
+// accepts only the escapes which pugixml decodes; '&' of the others is left as it is by pugixml.
+bool AMLReader::scanEscape(const char*& pos, const char* end)
+{
+    static const char* const ENTITIES[] = { "&amp;", "&apos;", "&gt;", "&lt;", "&quot;" };
+
+    for (const char* entity : ENTITIES)
+    {
+        if (startsWith(pos, end, entity))
+        {
+            pos += strlen(entity);
+            return true;
+        }
+    }
+
+    if (!startsWith(pos, end, "&#"))
+    {
+        return false;
+    }
+
+    const char* cur = pos + 2;
+    bool isHex = (cur != end && 'x' == *cur);
+    unsigned int code = 0;
+
+    if (isHex)
+    {
+        ++cur;
+    }
+
+    const char* digits = cur;
+    for (; cur != end && ';' != *cur; ++cur)
+    {
+        char ch = *cur;
+        if ('0' <= ch && ch <= '9')
+        {
+            code = (isHex ? 16 : 10) * code + (ch - '0');
+        }
+        else if (isHex && 'a' <= (ch | ' ') && (ch | ' ') <= 'f')
+        {
+            code = 16 * code + ((ch | ' ') - 'a' + 10);
+        }
+        else
+        {
+            return false;
+        }
+
+        if (MAX_CODE_POINT < code)
+        {
+            return false;
+        }
+    }
+
+    if (cur == end || digits == cur || 0 == code)
+    {
+        return false;
+    }
+
+    pos = cur + 1;
+    return true;
+}
+
+void AMLReader::decode(std::string& out, const char* begin, const char* end, bool isAttribute, bool hasEscapes)
+{
+    out.clear();
+
+    const char* pos = begin;
+    while (pos != end)
+    {
+        const char* run = pos;
+        while (pos != end && '\r' != *pos && !(hasEscapes && '&' == *pos) && !(isAttribute && ('\n' == *pos || '\t' == *pos)))
+        {
+            ++pos;
+        }
+        out.append(run, pos);
+
+        if (pos == end)
+        {
+            break;
+        }
+
+        switch (*pos)
+        {
+            case '\r':
+                // end-of-line is normalized as "\n", and is converted to a space in attribute
+                out.push_back(isAttribute ? ' ' : '\n');
+                ++pos;
+                if (pos != end && '\n' == *pos)
+                {
+                    ++pos;
+                }
+                break;
+            case '\n':
+            case '\t':
+                out.push_back(' ');
+                ++pos;
+                break;
+            default: // '&', validated by scanEscape()
+                if ('#' != pos[1])
+                {
+                    switch (pos[1])
+                    {
+                        case 'a':   out.push_back(('m' == pos[2]) ? '&' : '\'');    break;
+                        case 'g':   out.push_back('>');                             break;
+                        case 'l':   out.push_back('<');                             break;
+                        default:    out.push_back('"');                             break;
+                    }
+                    pos = static_cast<const char*>(memchr(pos, ';', end - pos)) + 1;
+                }
+                else
+                {
+                    bool isHex = ('x' == pos[2]);
+                    unsigned int code = 0;
+
+                    for (pos += isHex ? 3 : 2; ';' != *pos; ++pos)
+                    {
+                        char ch = *pos;
+                        if ('0' <= ch && ch <= '9')     code = (isHex ? 16 : 10) * code + (ch - '0');
+                        else                            code = 16 * code + ((ch | ' ') - 'a' + 10);
+                    }
+                    ++pos;
+
+                    appendUtf8(out, code);
+                }
+                break;
+        }
+    }
+}
+
+bool AMLReader::equals(const Span& span, const char* str)
+{
+    size_t length = strlen(str);
+    return static_cast<size_t>(span.end - span.begin) == length && 0 == memcmp(span.begin, str, length);
+}
@@ -0,0 +1,349 @@
+/*******************************************************************************
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *******************************************************************************/
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <cassert>
+
+#include "AMLTemplate.h"
+#include "AMLCache.h"
+#include "AMLWriter.h"
+#include "AMLInterface.h"
+#include "AMLException.h"
+#include "AMLLogger.h"
+
+#define TAG "AMLTemplate"
+
+using namespace std;
+using namespace AML;
+
+static void appendIndex(std::string& out, size_t index)
+{
+    char buf[24];
+    char* pos = buf + sizeof(buf);
+
+    do
+    {
+        *--pos = static_cast<char>('0' + (index % 10));
+        index /= 10;
+    } while (0 != index);
+
+    out.append(pos, buf + sizeof(buf));
+}
+
+AMLTemplate::AMLTemplate(void)
+{
+}
+
+std::string& AMLTemplate::text()
+{
+    return m_text;
+}
+
+void AMLTemplate::addSlot(SlotType type, const std::string& key)
+{
+    assert(SlotType::StringArray != type && SlotType::AMLData != type && SlotType::DataList != type);
+
+    Slot slot;
+    slot.type = type;
+    slot.key = key;
+    slot.offset = m_text.size();
+    slot.scopeEnd = 0;
+    slot.indexOffset = 0;
+    slot.valueOffset = 0;
+    slot.leadLength = 0;
+
+    m_slots.push_back(slot);
+}
+
+void AMLTemplate::addArraySlot(const std::string& key, const std::string& itemText,
+                               size_t indexOffset, size_t valueOffset, size_t leadLength)
+{
+    assert(leadLength <= indexOffset && indexOffset <= valueOffset && valueOffset <= itemText.size());
+
+    Slot slot;
+    slot.type = SlotType::StringArray;
+    slot.key = key;
+    slot.offset = m_text.size();
+    slot.scopeEnd = 0;
+    slot.itemText = itemText;
+    slot.indexOffset = indexOffset;
+    slot.valueOffset = valueOffset;
+    slot.leadLength = leadLength;
+
+    m_slots.push_back(slot);
+}
+
+void AMLTemplate::addDataListSlot(size_t leadLength)
+{
+    Slot slot;
+    slot.type = SlotType::DataList;
+    slot.offset = m_text.size();
+    slot.scopeEnd = 0;
+    slot.indexOffset = 0;
+    slot.valueOffset = 0;
+    slot.leadLength = leadLength;
+
+    m_slots.push_back(slot);
+}
+
+void AMLTemplate::beginDataScope(const std::string& key)
+{
+    Slot slot;
+    slot.type = SlotType::AMLData;
+    slot.key = key;
+    slot.offset = m_text.size();
+    slot.scopeEnd = 0;
+    slot.indexOffset = 0;
+    slot.valueOffset = 0;
+    slot.leadLength = 0;
+
+    m_scopes.push_back(m_slots.size());
+    m_slots.push_back(slot);
+}
+
+void AMLTemplate::endDataScope()
+{
+    assert(!m_scopes.empty());
+
+    m_slots[m_scopes.back()].scopeEnd = m_slots.size();
+    m_scopes.pop_back();
+}
+
+void AMLTemplate::render(std::string& out, const AMLData& amlData) const
+{
+    size_t textPos = renderSlots(out, 0, 0, m_slots.size(), &amlData, NULL, NULL);
+
+    out.append(m_text, textPos, std::string::npos);
+}
+
+void AMLTemplate::render(std::string& out, const AMLObject& amlObject, const AMLTemplateMap& templates) const
+{
+    size_t textPos = renderSlots(out, 0, 0, m_slots.size(), NULL, &amlObject, &templates);
+
+    out.append(m_text, textPos, std::string::npos);
+}
+
+void AMLTemplate::save(AMLCacheWriter& writer) const
+{
+    assert(m_scopes.empty());
+
+    writer.writeString(m_text);
+    writer.writeU64(m_slots.size());
+
+    for (const Slot& slot : m_slots)
+    {
+        writer.writeU8(static_cast<uint8_t>(slot.type));
+        writer.writeString(slot.key);
+        writer.writeU64(slot.offset);
+        writer.writeU64(slot.scopeEnd);
+        writer.writeString(slot.itemText);
+        writer.writeU64(slot.indexOffset);
+        writer.writeU64(slot.valueOffset);
+        writer.writeU64(slot.leadLength);
+    }
+}
+
+bool AMLTemplate::load(AMLCacheReader& reader, bool forObject)
+{
+    m_text.clear();
+    m_slots.clear();
+    m_scopes.clear();
+
+    uint64_t count;
+    if (!reader.readString(m_text) || !reader.readU64(count))
+    {
+        return false;
+    }
+
+    // AMLData scopes which are not closed yet, to check that scopes are nested
+    vector<size_t> scopeEnds;
+    size_t offset = 0;
+
+    for (uint64_t i = 0; i < count; ++i)
+    {
+        Slot slot;
+        uint8_t type;
+        uint64_t values[5];
+        if (!reader.readU8(type) || !reader.readString(slot.key) || !reader.readU64(values[0]) || !reader.readU64(values[1]) ||
+            !reader.readString(slot.itemText) || !reader.readU64(values[2]) || !reader.readU64(values[3]) || !reader.readU64(values[4]))
+        {
+            return false;
+        }
+
+        if (type > static_cast<uint8_t>(SlotType::DataList) ||
+            values[0] < offset || values[0] > m_text.size() ||
+            values[2] > values[3] || values[3] > slot.itemText.size() || values[4] > values[2])
+        {
+            return false;
+        }
+
+        slot.type = static_cast<SlotType>(type);
+        slot.offset = static_cast<size_t>(values[0]);
+        slot.scopeEnd = static_cast<size_t>(values[1]);
+        slot.indexOffset = static_cast<size_t>(values[2]);
+        slot.valueOffset = static_cast<size_t>(values[3]);
+        slot.leadLength = static_cast<size_t>(values[4]);
+        offset = slot.offset;
+
+        while (!scopeEnds.empty() && scopeEnds.back() == i)
+        {
+            scopeEnds.pop_back();
+        }
+
+        // values of AMLData are rendered only within AMLData, and values of AMLObject only out of it
+        bool inData = !forObject || !scopeEnds.empty();
+        switch (slot.type)
+        {
+            case SlotType::String:
+            case SlotType::StringArray:
+            case SlotType::AMLData:
+            case SlotType::Invalid:
+                if (!inData)
+                {
+                    return false;
+                }
+                break;
+
+            case SlotType::DeviceId:
+            case SlotType::TimeStamp:
+            case SlotType::Id:
+            case SlotType::DataList:
+                if (inData)
+                {
+                    return false;
+                }
+                break;
+        }
+
+        if (SlotType::AMLData == slot.type)
+        {
+            if (values[1] <= i || values[1] > count || (!scopeEnds.empty() && values[1] > scopeEnds.back()))
+            {
+                return false;
+            }
+            scopeEnds.push_back(slot.scopeEnd);
+        }
+
+        m_slots.push_back(slot);
+    }
+
+    return true;
+}
+
+size_t AMLTemplate::renderSlots(std::string& out, size_t textPos, size_t begin, size_t end,
+                                const AMLData* amlData, const AMLObject* amlObject, const AMLTemplateMap* templates) const
+{
+    for (size_t i = begin; i < end; ++i)
+    {
+        const Slot& slot = m_slots[i];
+
+        out.append(m_text, textPos, slot.offset - textPos);
+        textPos = slot.offset;
+
+        switch (slot.type)
+        {
+            case SlotType::String:
+                assert(nullptr != amlData);
+                AMLWriter::escape(out, amlData->getValueToStr(slot.key).c_str(), false);
+                break;
+
+            case SlotType::StringArray:
+            {
+                assert(nullptr != amlData);
+                const std::vector<std::string>& values = amlData->getValueToStrArr(slot.key);
+
+                if (values.empty())
+                {
+                    // the end tag of parent follows the text directly as well
+                    textPos += (0 == slot.leadLength) ? 0 : slot.leadLength - 1;
+                }
+
+                for (size_t index = 0, size = values.size(); index != size; ++index)
+                {
+                    size_t lead = (0 == index) ? slot.leadLength : 0;
+
+                    out.append(slot.itemText, lead, slot.indexOffset - lead);
+                    appendIndex(out, index + 1);
+                    out.append(slot.itemText, slot.indexOffset, slot.valueOffset - slot.indexOffset);
+                    AMLWriter::escape(out, values[index].c_str(), false);
+                    out.append(slot.itemText, slot.valueOffset, std::string::npos);
+                }
+                break;
+            }
+
+            case SlotType::AMLData:
+            {
+                assert(nullptr != amlData);
+                const AMLData& value = amlData->getValueToAMLData(slot.key);
+
+                textPos = renderSlots(out, textPos, i + 1, slot.scopeEnd, &value, amlObject, templates);
+                i = slot.scopeEnd - 1;
+                break;
+            }
+
+            case SlotType::Invalid:
+                AML_LOG_V(ERROR, TAG, "Invalid AML : <%s> has value of invalid type", slot.key.c_str());
+                throw AMLException(INVALID_AML_SCHEMA);
+
+            case SlotType::DeviceId:
+                assert(nullptr != amlObject);
+                AMLWriter::escape(out, amlObject->getDeviceId().c_str(), false);
+                break;
+
+            case SlotType::TimeStamp:
+                assert(nullptr != amlObject);
+                AMLWriter::escape(out, amlObject->getTimeStamp().c_str(), false);
+                break;
+
+            case SlotType::Id:
+                assert(nullptr != amlObject);
+                AMLWriter::escape(out, amlObject->getId().c_str(), false);
+                break;
+
+            case SlotType::DataList:
+            {
+                assert(nullptr != amlObject && nullptr != templates);
+                vector<string> dataNames = amlObject->getDataNames();
+
+                for (size_t index = 0, size = dataNames.size(); index != size; ++index)
+                {
+                    const string& name = dataNames[index];
+
+                    AMLTemplateMap::const_iterator iter = templates->find(name);
+                    if (iter == templates->end())
+                    {
+                        AML_LOG_V(ERROR, TAG, "Invalid Data : <%s> is not present in SystemUnitClassLib", name.c_str());
+                        throw AMLException(NOT_MATCH_TO_AML_MODEL);
+                    }
+
+                    size_t begin = out.size();
+                    iter->second.render(out, amlObject->getData(name));
+
+                    if (0 == index && 0 != slot.leadLength)
+                    {
+                        out.erase(begin, slot.leadLength);
+                    }
+                }
+                break;
+            }
+        }
+    }
+
+    return textPos;
+}
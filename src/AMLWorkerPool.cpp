@@ -0,0 +1,185 @@
+/*******************************************************************************
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *******************************************************************************/
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "AMLWorkerPool.h"
+
+using namespace std;
+using namespace AML;
+
+// number of ranges of indices for each thread, so that threads finishing early take the rest of the batch.
+static const size_t RANGES_PER_THREAD = 4;
+
+AMLWorkerPool::AMLWorkerPool(size_t threadCount)
+ : m_task(nullptr), m_count(0), m_grain(1), m_next(0), m_generation(0), m_busyCount(0), m_stopped(false)
+{
+    if (0 == threadCount)
+    {
+        threadCount = std::max(1u, thread::hardware_concurrency());
+    }
+
+    try
+    {
+        for (size_t i = 1; i < threadCount; ++i)
+        {
+            m_threads.push_back(thread(&AMLWorkerPool::work, this));
+        }
+    }
+    catch (...)
+    {
+        stop();
+        throw;
+    }
+}
+
+AMLWorkerPool::~AMLWorkerPool(void)
+{
+    stop();
+}
+
+size_t AMLWorkerPool::threadCount() const
+{
+    return m_threads.size() + 1;
+}
+
+void AMLWorkerPool::run(size_t count, const function<void(size_t)>& task)
+{
+    if (0 == count)
+    {
+        return;
+    }
+
+    if (m_threads.empty() || 1 == count)
+    {
+        for (size_t index = 0; index < count; ++index)
+        {
+            task(index);
+        }
+        return;
+    }
+
+    lock_guard<mutex> runLock(m_runMutex);
+    {
+        lock_guard<mutex> lock(m_mutex);
+        m_task = &task;
+        m_count = count;
+        m_grain = std::max<size_t>(1, count / (threadCount() * RANGES_PER_THREAD));
+        m_next = 0;
+        m_error = nullptr;
+        m_busyCount = m_threads.size();
+        ++m_generation;
+    }
+    m_started.notify_all();
+
+    runTasks();
+
+    exception_ptr error;
+    {
+        unique_lock<mutex> lock(m_mutex);
+        m_finished.wait(lock, [this]() { return 0 == m_busyCount; });
+        m_task = nullptr;
+        error = m_error;
+        m_error = nullptr;
+    }
+
+    if (error)
+    {
+        rethrow_exception(error);
+    }
+}
+
+void AMLWorkerPool::work()
+{
+    size_t generation = 0;
+    for (;;)
+    {
+        {
+            unique_lock<mutex> lock(m_mutex);
+            m_started.wait(lock, [this, generation]() { return m_stopped || generation != m_generation; });
+            if (m_stopped)
+            {
+                return;
+            }
+            generation = m_generation;
+        }
+
+        runTasks();
+
+        {
+            lock_guard<mutex> lock(m_mutex);
+            if (0 == --m_busyCount)
+            {
+                m_finished.notify_one();
+            }
+        }
+    }
+}
+
+// m_task, m_count and m_grain are set before the batch is started, and are not changed until all threads are finished.
+void AMLWorkerPool::runTasks()
+{
+    for (;;)
+    {
+        size_t begin = m_next.fetch_add(m_grain);
+        if (begin >= m_count)
+        {
+            return;
+        }
+
+        size_t end = std::min(begin + m_grain, m_count);
+        for (size_t index = begin; index < end; ++index)
+        {
+            try
+            {
+                (*m_task)(index);
+            }
+            catch (...)
+            {
+                lock_guard<mutex> lock(m_mutex);
+                if (!m_error)
+                {
+                    m_error = current_exception();
+                }
+                m_next = m_count;   // the items which are not started are skipped
+                return;
+            }
+        }
+    }
+}
+
+void AMLWorkerPool::stop()
+{
+    {
+        lock_guard<mutex> lock(m_mutex);
+        m_stopped = true;
+    }
+    m_started.notify_all();
+
+    for (thread& worker : m_threads)
+    {
+        worker.join();
+    }
+    m_threads.clear();
+}
@@ -0,0 +1,209 @@
+/*******************************************************************************
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *******************************************************************************/
+
+#include <string.h>
+#include <string>
+
+#include "AMLWriter.h"
+
+using namespace std;
+using namespace AML;
+
+static const char INDENT                = '\t';
+
+static const unsigned int INDENT_NEWLINE = 1;
+static const unsigned int INDENT_INDENT  = 2;
+
+static const unsigned char SPECIAL_PCDATA   = 1;
+static const unsigned char SPECIAL_ATTR     = 2;
+
+/*
+ * Characters which have to be escaped, the same as pugixml's 'chartypex_table'.
+ * PCDATA : 0~31 except \t, \n, \r and '&', '<', '>'
+ * Attribute : 0~31 except \t and '&', '<', '>', '"'
+ */
+static const unsigned char SPECIAL_CHAR[256] =
+{
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 0, 2, 3, 3, 2, 3, 3,     // 0-15
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,     // 16-31
+    0, 0, 2, 0, 0, 0, 3, 0, 0, 0, 0, 0, 0, 0, 0, 0,     // 32-47
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 3, 0, 3, 0,     // 48-63
+};
+
+AMLWriter::AMLWriter(std::string& out, unsigned int depth)
+ : m_out(out), m_depth(depth), m_indentFlags(INDENT_INDENT), m_startTagOpened(false)
+{
+}
+
+void AMLWriter::declaration()
+{
+    indent();
+    m_out.append("<?xml version=\"1.0\" encoding=\"utf-8\"?>");
+    m_indentFlags = INDENT_NEWLINE | INDENT_INDENT;
+}
+
+void AMLWriter::startElement(const char* name)
+{
+    closeStartTag();
+    indent();
+
+    m_out.push_back('<');
+    m_out.append(name);
+
+    m_startTagOpened = true;
+    m_indentFlags = INDENT_NEWLINE | INDENT_INDENT;
+    ++m_depth;
+}
+
+void AMLWriter::attribute(const char* name, const char* value)
+{
+    m_out.push_back(' ');
+    m_out.append(name);
+    m_out.append("=\"");
+    escape(m_out, value, true);
+    m_out.push_back('"');
+}
+
+void AMLWriter::text(const char* value)
+{
+    closeStartTag();
+    escape(m_out, value, false);
+
+    m_indentFlags = 0;
+}
+
+void AMLWriter::cdata(const char* value)
+{
+    closeStartTag();
+
+    // "]]>" is split into two CDATA sections as pugixml does.
+    m_out.append("<![CDATA[");
+    const char* prev = value;
+    for (const char* pos = strstr(value, "]]>"); NULL != pos; pos = strstr(prev, "]]>"))
+    {
+        m_out.append(prev, pos + 2);
+        m_out.append("]]><![CDATA[");
+        prev = pos + 2;
+    }
+    m_out.append(prev);
+    m_out.append("]]>");
+
+    m_indentFlags = 0;
+}
+
+void AMLWriter::endElement(const char* name)
+{
+    --m_depth;
+
+    if (m_startTagOpened)
+    {
+        // element without any child
+        m_out.append(" />");
+        m_startTagOpened = false;
+    }
+    else
+    {
+        indent();
+        m_out.append("</");
+        m_out.append(name);
+        m_out.push_back('>');
+    }
+
+    m_indentFlags = INDENT_NEWLINE | INDENT_INDENT;
+}
+
+void AMLWriter::beginChildren()
+{
+    closeStartTag();
+
+    m_indentFlags = INDENT_NEWLINE | INDENT_INDENT;
+}
+
+void AMLWriter::finish()
+{
+    if (m_indentFlags & INDENT_NEWLINE)
+    {
+        m_out.push_back('\n');
+    }
+}
+
+void AMLWriter::closeStartTag()
+{
+    if (m_startTagOpened)
+    {
+        m_out.push_back('>');
+        m_startTagOpened = false;
+    }
+}
+
+void AMLWriter::indent()
+{
+    if (m_indentFlags & INDENT_NEWLINE)
+    {
+        m_out.push_back('\n');
+    }
+    if (m_indentFlags & INDENT_INDENT)
+    {
+        m_out.append(m_depth, INDENT);
+    }
+}
+
+void AMLWriter::escape(std::string& out, const char* value, bool isAttribute)
+{
+    const unsigned char mask = isAttribute ? SPECIAL_ATTR : SPECIAL_PCDATA;
+    const unsigned char* pos = reinterpret_cast<const unsigned char*>(value);
+
+    while (*pos)
+    {
+        const unsigned char* prev = pos;
+        while (*pos && 0 == (SPECIAL_CHAR[*pos] & mask))
+        {
+            ++pos;
+        }
+        out.append(reinterpret_cast<const char*>(prev), pos - prev);
+
+        switch (*pos)
+        {
+            case 0:
+                break;
+            case '&':
+                out.append("&amp;");
+                ++pos;
+                break;
+            case '<':
+                out.append("&lt;");
+                ++pos;
+                break;
+            case '>':
+                out.append("&gt;");
+                ++pos;
+                break;
+            case '"':
+                out.append("&quot;");
+                ++pos;
+                break;
+            default: // control character
+            {
+                unsigned int ch = *pos++;
+                out.append("&#");
+                out.push_back(static_cast<char>((ch / 10) + '0'));
+                out.push_back(static_cast<char>((ch % 10) + '0'));
+                out.push_back(';');
+            }
+        }
+    }
+}
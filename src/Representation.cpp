@@ -17,9 +17,19 @@
 
 #include <string.h>
 #include <string>
-#include <sstream>
 #include <vector>
+#include <utility>
+#include <memory>
 #include <cassert>
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <unordered_map>
 
 #include "pugixml.hpp"
 
@@ -27,6 +37,13 @@
 #include "AMLInterface.h"
 #include "AMLException.h"
 #include "AMLLogger.h"
+#include "AMLWriter.h"
+#include "AMLTemplate.h"
+#include "AMLReader.h"
+#include "AMLKeyTable.h"
+#include "AMLArena.h"
+#include "AMLWorkerPool.h"
+#include "AMLCache.h"
 
 #ifndef _DISABLE_PROTOBUF_
 #include "AML.pb.h"
@@ -61,12 +78,17 @@ static const char ORDERED_LIST_TYPE[]               = "OrderedListType";
 
 static const char EVENT[]                           = "Event";
 
+// compiled-model cache, whose version is increased whenever the layout or the compiled templates are changed
+static const char CACHE_MAGIC[8]                    = {'A', 'M', 'L', 'M', 'O', 'D', 'E', 'L'};
+static const uint32_t CACHE_VERSION                 = 1;
+static const size_t CACHE_HEADER_SIZE               = sizeof(CACHE_MAGIC) + 4 + 8 * 3;
+static const char CACHE_FILE_EXTENSION[]            = ".amlc";
+
 static const char KEY_DEVICE[]                      = "device";
 static const char KEY_ID[]                          = "id";
 static const char KEY_TIMESTAMP[]                   = "timestamp";
 
 #define IS_NAME(node, name)                     (std::string((node).attribute(NAME).value()) == (name))
-#define ADD_VALUE(node, value)                  ((node).append_child(VALUE).text().set((value).c_str())) //#TODO: verify non-null after append_child()
 
 #define VERIFY_NON_NULL_THROW_EXCEPTION(var)    if (NULL == (var)) throw AMLException(NO_MEMORY); 
 
@@ -95,72 +117,238 @@ static void extractAttribute(T* attr, pugi::xml_node xmlNode);
 template <typename T>
 static void extractInternalElement(T* ie, pugi::xml_node xmlNode);
 
-template <typename T>
-static void extractProtoAttribute(pugi::xml_node xmlNode, T* attr);
+static void setAttribute(datamodel::Attribute* attr, pugi::xml_node xmlAttr);
+#endif // _DISABLE_PROTOBUF_
 
-template <typename T>
-static void extractProtoInternalElement(pugi::xml_node xmlNode, T* ie);
+#ifndef _DISABLE_PROTOBUF_
+// Memory of the CAEXFile kept by a thread between conversions, which is enough for thousands of attributes.
+static const size_t MAX_THREAD_CAEX_SPACE = 1 << 20;
+
+// Number of conversions of a thread between checks of its CAEXFile, unless a conversion has a larger message than before.
+static const unsigned int THREAD_CAEX_CHECK_INTERVAL = 256;
+
+// CAEXFile reused by DataToByte() and ByteToData() of the calling thread, while an instance of this class is alive.
+// Clear() keeps nested messages and strings allocated, so a conversion rarely allocates memory for the message.
+// If the message grows over MAX_THREAD_CAEX_SPACE, it is released at the end of the conversion which measures it,
+// so that a rare large event is not retained by the thread (e.g. by each worker thread of AMLWorkerPool) until it exits.
+class ThreadCaexFile
+{
+public:
+    ThreadCaexFile() : m_state(state()), m_byteSize(0)
+    {
+    }
+
+    ~ThreadCaexFile()
+    {
+        // SpaceUsedLong() walks the whole message, so it is called only when the message may have grown.
+        ++m_state.conversions;
+        if (m_byteSize <= m_state.maxByteSize && 0 != m_state.conversions % THREAD_CAEX_CHECK_INTERVAL)
+        {
+            return;
+        }
+
+        m_state.maxByteSize = std::max(m_state.maxByteSize, m_byteSize);
+        if (m_state.caex.SpaceUsedLong() > MAX_THREAD_CAEX_SPACE)
+        {
+            datamodel::CAEXFile().Swap(&m_state.caex);
+            m_state.maxByteSize = 0;
+        }
+    }
+
+    datamodel::CAEXFile& get()
+    {
+        return m_state.caex;
+    }
+
+    // Sets the serialized size of the message, which is parsed or serialized by the conversion.
+    void setByteSize(size_t byteSize)
+    {
+        m_byteSize = byteSize;
+    }
+
+private:
+    ThreadCaexFile(const ThreadCaexFile&) = delete;
+    ThreadCaexFile& operator=(const ThreadCaexFile&) = delete;
+
+    struct State
+    {
+        State() : maxByteSize(0), conversions(0)
+        {
+        }
+
+        datamodel::CAEXFile caex;
+        size_t maxByteSize;         // largest serialized size since the message is checked or released
+        unsigned int conversions;
+    };
+
+    static State& state()
+    {
+        static thread_local State threadState;
+        return threadState;
+    }
+
+    State& m_state;
+    size_t m_byteSize;
+};
 #endif // _DISABLE_PROTOBUF_
 
-template <typename T>
-static std::string toString(const T& t)
+// Buffers reused by the decoders of the calling thread, which keep their capacity for the next conversion.
+struct DecodeBuffer
+{
+    DecodeBuffer() : reader(nullptr, nullptr)
+    {
+    }
+
+    AMLReader reader;
+    std::string deviceId, timeStamp, id;
+    std::string name;                                       // name of <InternalElement> or <Attribute> of Event
+    std::string text;                                       // text of <Value>
+    std::vector<std::string> names;                         // names of <Attribute>s by depth
+    std::vector<std::pair<std::string, std::string>> items; // names and values of items of ordered list
+    std::vector<std::string> values;                        // values of ordered list in order of the names
+    std::vector<bool> isSet;
+};
+
+static DecodeBuffer& threadDecodeBuffer()
 {
-    std::ostringstream ss;
-    ss << t;
-    return ss.str();
+    static thread_local DecodeBuffer buffer;
+    return buffer;
+}
+
+// parses the name of an item of ordered list("1", "2", "3"...) which is not larger than max
+static bool toIndex(const std::string& name, size_t max, size_t& index)
+{
+    if (name.empty() || '0' == name[0])
+    {
+        return false;
+    }
+
+    index = 0;
+    for (char ch : name)
+    {
+        if (ch < '0' || ch > '9')
+        {
+            return false;
+        }
+
+        index = index * 10 + (ch - '0');
+        if (index > max)
+        {
+            return false;
+        }
+    }
+    return true;
 }
 
+#ifndef _DISABLE_PROTOBUF_
+// <Attribute> of a SystemUnitClass, classified once by the type of its value so that encoding does not inspect the model.
+struct AttributeSchema
+{
+    enum class Type
+    {
+        Described,      // has <Description>, whose string value is added only if it is the only child
+        String,
+        StringArray,
+        AMLData,
+        Invalid         // reported when an AMLData of the SystemUnitClass is encoded
+    };
+
+    pugi::xml_node node;
+    std::string name;
+    Type type;
+    bool hasValue;                              // for Described
+    std::vector<AttributeSchema> attributes;    // for AMLData
+};
+#endif // _DISABLE_PROTOBUF_
+
+// SystemUnitClass of the model, indexed by its name
+struct SystemUnitClass
+{
+    pugi::xml_node node;
+#ifndef _DISABLE_PROTOBUF_
+    std::vector<AttributeSchema> attributes;
+#endif
+};
+
 class Representation::AMLModel
 {
 public:
-    AMLModel (const std::string& amlFilePath)
+    AMLModel (const std::string& amlFilePath) : m_source(nullptr), m_sourceSize(0), m_hasEventTemplate(false)
     {
-        m_doc = new pugi::xml_document();
+        std::unique_ptr<pugi::xml_document> doc(new pugi::xml_document());
 
-        pugi::xml_parse_result result = m_doc->load_file(amlFilePath.c_str());
+        pugi::xml_parse_result result = doc->load_file(amlFilePath.c_str());
         if (pugi::status_ok != result.status) 
         {
             AML_LOG_V(ERROR, TAG, "Failed to load file : %s", amlFilePath.c_str());
-            delete m_doc;
             throw AMLException(INVALID_FILE_PATH);
         }
 
-        pugi::xml_node xmlCaexFile = m_doc->child(CAEX_FILE);
-        if (NULL == xmlCaexFile)
-        {
-            AML_LOG(ERROR, TAG, "Invalid AML File : <CAEXFile> does not exist");
-            delete m_doc;
-            throw AMLException(INVALID_AML_SCHEMA);
-        }
+        setDocument(std::move(doc));
+        compile();
+    }
 
-        m_systemUnitClassLib = xmlCaexFile.child(SYSTEM_UNIT_CLASS_LIB);
-        if (NULL == m_systemUnitClassLib) 
+    // AML in a buffer is copied by the parser, unless it is parsed in place and the document refers to the buffer.
+    AMLModel (const char* amlBuffer, size_t size, bool parseInPlace) : m_source(nullptr), m_sourceSize(0), m_hasEventTemplate(false)
+    {
+        if (NULL == amlBuffer)
         {
-            AML_LOG(ERROR, TAG, "Invalid AML File : <SystemUnitClassLib> does not exist");
-            delete m_doc;
-            throw AMLException(INVALID_AML_SCHEMA);
+            AML_LOG(ERROR, TAG, "Buffer is null");
+            throw AMLException(INVALID_PARAM);
         }
 
-        m_roleClassLib = xmlCaexFile.child(ROLE_CLASS_LIB);
-        if (NULL == m_roleClassLib) 
+        std::unique_ptr<pugi::xml_document> doc(new pugi::xml_document());
+
+        pugi::xml_parse_result result = parseInPlace ? doc->load_buffer_inplace(const_cast<char*>(amlBuffer), size)
+                                                     : doc->load_buffer(amlBuffer, size);
+        if (pugi::status_ok != result.status)
         {
-            AML_LOG(ERROR, TAG, "Invalid AML File : <RoleClassLib> does not exist");
-            delete m_doc;
-            throw AMLException(INVALID_AML_SCHEMA);
+            AML_LOG(ERROR, TAG, "Failed to load buffer : Invalid XML");
+            throw AMLException(INVALID_XML_STR);
         }
 
-        // remove "AdditionalInformation" and "InstanceHierarchy" data
-        while (xmlCaexFile.child(ADDITIONAL_INFORMATION))   xmlCaexFile.remove_child(ADDITIONAL_INFORMATION);
-        while (xmlCaexFile.child(INSTANCE_HIERARCHY))       xmlCaexFile.remove_child(INSTANCE_HIERARCHY);
+        setDocument(std::move(doc));
+        compile();
     }
 
-    ~AMLModel()
+    // The model compiled from the same AML is loaded from the cache, otherwise it is compiled and written to the cache.
+    // Failure to read or write the cache is not an error, as the model can be compiled from AML.
+    AMLModel (const std::string& amlFilePath, const std::string& cacheDirPath) : m_source(nullptr), m_sourceSize(0), m_hasEventTemplate(false)
     {
-        delete m_doc;
+        std::string source;
+        if (!readFile(amlFilePath, source))
+        {
+            AML_LOG_V(ERROR, TAG, "Failed to load file : %s", amlFilePath.c_str());
+            throw AMLException(INVALID_FILE_PATH);
+        }
+
+        uint64_t sourceHash = hashContent(source.data(), source.size());
+        std::string cacheFilePath = cacheFileName(cacheDirPath, sourceHash);
+
+        if (loadCache(cacheFilePath, sourceHash, source))
+        {
+            return;
+        }
+
+        std::unique_ptr<pugi::xml_document> doc(new pugi::xml_document());
+
+        pugi::xml_parse_result result = doc->load_buffer(source.data(), source.size());
+        if (pugi::status_ok != result.status)
+        {
+            AML_LOG_V(ERROR, TAG, "Failed to load file : %s", amlFilePath.c_str());
+            throw AMLException(INVALID_FILE_PATH);
+        }
+
+        setDocument(std::move(doc));
+        compile();
+
+        saveCache(cacheFilePath, sourceHash, source);
     }
 
     AMLObject* constructConfigAmlObject()
     {
+        ensureDocument();
+
         std::string deviceName(m_roleClassLib.attribute(NAME).value());
 
         AMLObject* amlObj = new AMLObject(deviceName, "0");
@@ -173,26 +361,26 @@ public:
                 continue;
             }
 
-            pugi::xml_node xml_rc = m_roleClassLib.find_child_by_attribute(ROLE_CLASS, NAME, className.c_str());
-            if (NULL == xml_rc) 
+            std::unordered_map<std::string, pugi::xml_node>::const_iterator iter = m_roleClasses.find(className);
+            if (iter == m_roleClasses.end())
             {
                 AML_LOG_V(ERROR, TAG, "Invalid AML File : <RoleClass NAME=\"%s\"> does not exist", className.c_str());
                 throw AMLException(KEY_NOT_EXIST); //@TODO: need to be more specific
             }
 
-            AMLData amlData;
-            for (pugi::xml_node xml_attr = xml_rc.child(ATTRIBUTE); xml_attr; xml_attr = xml_attr.next_sibling(ATTRIBUTE))
+            AMLData amlData(m_keyTable);
+            for (pugi::xml_node xml_attr = iter->second.child(ATTRIBUTE); xml_attr; xml_attr = xml_attr.next_sibling(ATTRIBUTE))
             {
                 amlData.setValue(xml_attr.attribute(NAME).value(), xml_attr.child_value(VALUE));
             }
 
-            amlObj->addData(className, amlData);
+            amlObj->addData(className, std::move(amlData));
         }
 
         return amlObj;
     }
 
-    AMLObject* constructAmlObject(pugi::xml_document* xml_doc)
+    AMLObject* constructAmlObject(pugi::xml_document* xml_doc, AMLObject* target, AMLArena* arena)
     {
         assert(nullptr != xml_doc);
 
@@ -218,104 +406,327 @@ public:
             else if (IS_NAME(xml_attr, KEY_ID))         id = xml_attr.child_value(VALUE);
         }
 
-        AMLObject* amlObj = new AMLObject(deviceId, timeStamp, id);
+        AMLObject* amlObj = createAmlObject(target, deviceId, timeStamp, id, arena);
+
+        try
+        {
+            for (pugi::xml_node xml_ie = xml_event.child(INTERNAL_ELEMENT); xml_ie; xml_ie = xml_ie.next_sibling(INTERNAL_ELEMENT))
+            {
+                addAmlData(*amlObj, xml_ie.attribute(NAME).value(), xml_ie);
+            }
+        }
+        catch (const AMLException&)
+        {
+            deleteAmlObject(amlObj, target, arena);
+            throw;
+        }
+
+        return amlObj;
+    }
+
+#ifndef _DISABLE_PROTOBUF_
+    // Converts CAEXFile to AMLObject directly, with the same rules as constructAmlObject() for XML.
+    // Strings are taken up to the first null character as XML does not have it.
+    AMLObject* constructAmlObject(const datamodel::CAEXFile& caex, AMLObject* target, AMLArena* arena)
+    {
+        if (0 == caex.instancehierarchy_size())
+        {
+            AML_LOG(ERROR, TAG, "<CAEXFile> or <InstanceHierarchy> does not exist");
+            throw AMLException(INVALID_AML_SCHEMA);
+        }
+
+        const datamodel::InternalElement* event = nullptr;
+        for (const datamodel::InternalElement& ie : caex.instancehierarchy(0).internalelement())
+        {
+            if (0 == strcmp(ie.name().c_str(), EVENT))
+            {
+                event = &ie;
+                break;
+            }
+        }
+        if (nullptr == event)
+        {
+            AML_LOG(ERROR, TAG, "<Event> does not exist");
+            throw AMLException(INVALID_AML_SCHEMA);
+        }
 
-        for (pugi::xml_node xml_ie = xml_event.child(INTERNAL_ELEMENT); xml_ie; xml_ie = xml_ie.next_sibling(INTERNAL_ELEMENT))
+        DecodeBuffer& buffer = threadDecodeBuffer();
+        buffer.deviceId.clear();
+        buffer.timeStamp.clear();
+        buffer.id.clear();
+        for (const datamodel::Attribute& attr : event->attribute())
         {
-            AMLData amlData = constructAmlData(xml_ie);
-            std::string name = xml_ie.attribute(NAME).value();
+            const char* name = attr.name().c_str();
+
+            if      (0 == strcmp(name, KEY_DEVICE))     buffer.deviceId = attr.value().c_str();
+            else if (0 == strcmp(name, KEY_TIMESTAMP))  buffer.timeStamp = attr.value().c_str();
+            else if (0 == strcmp(name, KEY_ID))         buffer.id = attr.value().c_str();
+        }
 
-            amlObj->addData(name, amlData);
+        AMLObject* amlObj = createAmlObject(target, buffer.deviceId, buffer.timeStamp, buffer.id, arena);
+
+        try
+        {
+            for (const datamodel::InternalElement& ie : event->internalelement())
+            {
+                addAmlData(*amlObj, cString(ie.name(), buffer.name), ie);
+            }
+        }
+        catch (const AMLException&)
+        {
+            deleteAmlObject(amlObj, target, arena);
+            throw;
         }
 
         return amlObj;
     }
 
-    pugi::xml_document* constructXmlDoc()
+    template <typename T>
+    void constructAmlData(const T& parent, AMLData& amlData)
     {
-        pugi::xml_document* xml_doc = new pugi::xml_document();
+        std::string keyBuffer, valueBuffer;
+        for (const datamodel::Attribute& attr : parent.attribute())
+        {
+            const std::string& key = cString(attr.name(), keyBuffer);
+
+            if (attr.has_value())
+            {
+                // copied into the storage of the value reused by AMLData
+                amlData.setValue(key, cString(attr.value(), valueBuffer));
+            }
+            else if (attr.has_refsemantic())
+            {
+                DecodeBuffer& buffer = threadDecodeBuffer();
+                std::vector<std::string>& values = buffer.values;
+                std::vector<bool>& isSet = buffer.isSet;
+                values.resize(attr.attribute_size());
+                isSet.assign(attr.attribute_size(), false);
 
-        initializeAML(xml_doc);
+                for (const datamodel::Attribute& item : attr.attribute())
+                {
+                    size_t index = 0;
+                    if (!toIndex(item.name().c_str(), values.size(), index) || isSet[index - 1])
+                    {
+                        AML_LOG_V(ERROR, TAG, "Invalid AML : <%s> has an item of invalid name", key.c_str());
+                        throw AMLException(INVALID_AML_SCHEMA);
+                    }
+
+                    values[index - 1] = item.value().c_str();
+                    isSet[index - 1] = true;
+                }
 
-        return xml_doc;
+                // copied into the storage of the value reused by AMLData
+                amlData.setValue(key, values);
+            }
+            else if (0 != attr.attribute_size())
+            {
+                addAmlData(amlData, key, attr);
+            }
+            else
+            {
+                AML_LOG_V(ERROR, TAG, "Invalid AML : <%s> has value of invalid type", key.c_str());
+                throw AMLException(INVALID_AML_SCHEMA);
+            }
+        }
     }
 
-    pugi::xml_document* constructXmlDoc(const AMLObject& amlObject)
+    // Strings are taken up to the first null character as XML does not have it.
+    // The string is used without a copy unless it has a null character.
+    static const std::string& cString(const std::string& str, std::string& buffer)
     {
-        pugi::xml_document* xml_doc = constructXmlDoc();
-        // add InstanceHierarchy
-        pugi::xml_node xml_ih = xml_doc->child(CAEX_FILE).append_child(INSTANCE_HIERARCHY);
-        VERIFY_NON_NULL_THROW_EXCEPTION(xml_ih);
+        if (strlen(str.c_str()) == str.size())
+        {
+            return str;
+        }
+        buffer = str.c_str();
+        return buffer;
+    }
+#endif // _DISABLE_PROTOBUF_
 
-        xml_ih.append_attribute(NAME) = m_systemUnitClassLib.attribute(NAME).value(); // set IH name to be the same as SUCL name
+    // Reads AMLObject from XML text in a single pass, without building a DOM.
+    // Returns nullptr if the text is not a valid AML, has XML constructs which AMLReader does not handle,
+    // or has children in an order which is not written by DataToAml(),
+    // then constructAmlObject() with pugixml has to be used instead, which reports the exact error.
+    AMLObject* readAmlObject(const char* begin, const char* end, AMLObject* target, AMLArena* arena)
+    {
+        DecodeBuffer& buffer = threadDecodeBuffer();
+        buffer.reader.reset(begin, end);
+        AMLObject* amlObj = nullptr;
+
+        try
+        {
+            if (readCaexFile(buffer, amlObj, target, arena))
+            {
+                return amlObj;
+            }
+        }
+        catch (const AMLException&)
+        {
+            // not logged here, as the same error is reported by constructAmlObject()
+        }
+
+        deleteAmlObject(amlObj, target, arena);
+        return nullptr;
+    }
+
+#ifndef _DISABLE_PROTOBUF_
+    // Converts AMLObject to CAEXFile directly from the model, without building a DOM.
+    // SystemUnitClasses are copied as <InternalElement>s with values of AMLData, same as the templates of writeXml().
+    void constructCaexFile(const AMLObject& amlObject, datamodel::CAEXFile* caex)
+    {
+        assert(nullptr != caex);
+
+        ensureDocument();
+
+        caex->set_filename("");
+        caex->set_schemaversion("2.15");
+        caex->set_xsi("CAEX_ClassModel_V2.15.xsd");
+        caex->set_xmlns("http://www.w3.org/2001/XMLSchema-instance");
+
+        // add InstanceHierarchy
+        datamodel::InstanceHierarchy* ih = caex->add_instancehierarchy();
+        ih->set_name(m_systemUnitClassLib.attribute(NAME).value()); // set IH name to be the same as SUCL name
 
         // add Event as InternalElement
-        pugi::xml_node xml_event = addInternalElement(xml_ih, EVENT);
-        assert(NULL != xml_event);
+        pugi::xml_node xml_event = findSystemUnitClass(EVENT).node;
+        datamodel::InternalElement* event = ih->add_internalelement();
+        setInternalElement(event, xml_event, EVENT);
 
         // set default attributes of Event (This has a dependency on AMLObject class..)
         for (pugi::xml_node xml_attr = xml_event.child(ATTRIBUTE); xml_attr; xml_attr = xml_attr.next_sibling(ATTRIBUTE))
         {
-            if      (IS_NAME(xml_attr, KEY_DEVICE))     ADD_VALUE(xml_attr, amlObject.getDeviceId());
-            else if (IS_NAME(xml_attr, KEY_TIMESTAMP))  ADD_VALUE(xml_attr, amlObject.getTimeStamp());
-            else if (IS_NAME(xml_attr, KEY_ID))         ADD_VALUE(xml_attr, amlObject.getId());
+            datamodel::Attribute* attr = event->add_attribute();
+            setAttribute(attr, xml_attr);
+            extractAttribute<datamodel::Attribute>(attr, xml_attr);
+
+            if      (IS_NAME(xml_attr, KEY_DEVICE))     appendValue(attr, amlObject.getDeviceId());
+            else if (IS_NAME(xml_attr, KEY_TIMESTAMP))  appendValue(attr, amlObject.getTimeStamp());
+            else if (IS_NAME(xml_attr, KEY_ID))         appendValue(attr, amlObject.getId());
         }
+        extractInternalElement<datamodel::InternalElement>(event, xml_event);
 
         // add AMLDatas into Event
         vector<string> dataNames = amlObject.getDataNames();
 
-        for (string name : dataNames)
+        for (const string& name : dataNames)
         {
-            AMLData data = amlObject.getData(name);
-
-            pugi::xml_node xml_ie = addInternalElement(xml_event, name);
+            const SystemUnitClass& suc = findSystemUnitClass(name);
+            datamodel::InternalElement* ie = event->add_internalelement();
+            setInternalElement(ie, suc.node, name);
 
-            setAttributeValue(xml_ie, &data);
+            extractDataAttribute<datamodel::InternalElement>(ie, suc.attributes, amlObject.getData(name));
+            extractInternalElement<datamodel::InternalElement>(ie, suc.node);
         }
-        return xml_doc;
     }
+#endif // _DISABLE_PROTOBUF_
 
-    void appendModel(pugi::xml_document* xml_doc)
+    void writeXml(const AMLObject& amlObject, std::string& out)
     {
-        assert(nullptr != xml_doc);
-        xml_doc->child(CAEX_FILE).append_copy(m_roleClassLib);
-        xml_doc->child(CAEX_FILE).append_copy(m_systemUnitClassLib);
+        if (false == m_hasEventTemplate)
+        {
+            AML_LOG_V(ERROR, TAG, "Invalid Data : <%s> is not present in SystemUnitClassLib", EVENT);
+            throw AMLException(NOT_MATCH_TO_AML_MODEL);
+        }
+
+        const AMLTemplate& eventTemplate = amlObject.getDataNames().empty() ? m_emptyEventTemplate : m_eventTemplate;
+
+        eventTemplate.render(out, amlObject, m_templates);
     }
 
     std::string constructModelId()
     {
-        std::string suclName(m_systemUnitClassLib.attribute(NAME).value());
-        std::string suclVersion(m_systemUnitClassLib.child_value(VERSION));
-
-        std::string modelId = suclName + "_" + suclVersion;
-
-        return modelId;
+        return m_modelId;
     }
 
 private:
-    pugi::xml_document* m_doc;
+    std::unique_ptr<pugi::xml_document> m_doc;  // parsed on demand if the model is loaded from a cache
+    std::once_flag m_documentOnce;
+    AMLMappedFile m_cache;
+    const char* m_source;               // AML in m_cache, which is parsed on demand
+    size_t m_sourceSize;
     pugi::xml_node m_systemUnitClassLib;
     pugi::xml_node m_roleClassLib;
+    std::unordered_map<std::string, SystemUnitClass> m_systemUnitClasses;  // the first one of each name, as find_child_by_attribute() takes
+    std::unordered_map<std::string, pugi::xml_node> m_roleClasses;
+    std::shared_ptr<const AMLKeyTable> m_keyTable;  // attribute names of the model, which are keys of decoded AMLData
+    AMLTemplateMap m_templates;         // templates of <InternalElement> for each SystemUnitClass
+    AMLTemplate m_eventTemplate;        // whole document with Event which has AMLData
+    AMLTemplate m_emptyEventTemplate;   // whole document with Event which has no AMLData
+    bool m_hasEventTemplate;
+    std::string m_modelId;
+
+    // Returns target reset with the ids if it is given to be reused, otherwise a new AMLObject.
+    // AMLObject which is decoded in the arena is owned by it, so it is not deleted but reclaimed by AMLArena::reset().
+    static AMLObject* createAmlObject(AMLObject* target, const std::string& deviceId, const std::string& timeStamp, const std::string& id,
+                                      AMLArena* arena)
+    {
+        if (nullptr != target)
+        {
+            target->reset(deviceId, timeStamp, id);
+            return target;
+        }
+        if (nullptr == arena)
+        {
+            return new AMLObject(deviceId, timeStamp, id);
+        }
+        return arena->construct<AMLObject>(deviceId, timeStamp, id, arena);
+    }
+
+    static void deleteAmlObject(AMLObject* amlObj, const AMLObject* target, AMLArena* arena)
+    {
+        if (amlObj != target && nullptr == arena)
+        {
+            delete amlObj;
+        }
+    }
 
-    void initializeAML(pugi::xml_document* xml_doc)
+    AMLData& emplaceAmlData(AMLObject& amlObj, const std::string& name)
     {
-        pugi::xml_node xml_decl = xml_doc->prepend_child(pugi::node_declaration);
-        xml_decl.append_attribute("version") = "1.0";
-        xml_decl.append_attribute("encoding") = "utf-8";
-        //xml_decl.append_attribute("standalone") = "yes";
+        return amlObj.emplaceData(name, m_keyTable);
+    }
+
+    static AMLData& emplaceAmlData(AMLData& amlData, const std::string& key)
+    {
+        return amlData.emplaceData(key);
+    }
 
-        pugi::xml_node xml_caexFile = xml_doc->append_child(CAEX_FILE);
-        VERIFY_NON_NULL_THROW_EXCEPTION(xml_caexFile);
-        xml_caexFile.append_attribute("FileName") = "";
-        xml_caexFile.append_attribute("SchemaVersion") = "2.15";
-        xml_caexFile.append_attribute("xsi:noNamespaceSchemaLocation") = "CAEX_ClassModel_V2.15.xsd";
-        xml_caexFile.append_attribute("xmlns:xsi") = "http://www.w3.org/2001/XMLSchema-instance";
+    // AMLData is added before its values are decoded into it, so that AMLData removed by AMLObject::reset() is reused.
+    // If it can not be added, the values are decoded into a temporary AMLData before the error is thrown,
+    // so that an invalid value is reported first as when AMLData was added after being decoded.
+    template <typename P, typename T>
+    void addAmlData(P& parent, const std::string& name, const T& node)
+    {
+        AMLData* amlData = nullptr;
+        try
+        {
+            amlData = &emplaceAmlData(parent, name);
+        }
+        catch (const AMLException&)
+        {
+            AMLData values(m_keyTable);
+            constructAmlData(node, values);
+            throw;
+        }
+        constructAmlData(node, *amlData);
     }
 
-    AMLData constructAmlData(pugi::xml_node xml_ie)
+    // RoleClassLib and SystemUnitClassLib are the same for every output of writeXml(),
+    // so they are rendered once with the end of <CAEXFile>, as the text that follows </InstanceHierarchy>.
+    void renderModelXml(std::string& modelXml)
     {
-        AMLData amlData;
+        modelXml.push_back('\n');
+
+        AMLWriter writer(modelXml, 1);
+
+        writeNode(writer, m_roleClassLib);
+        writeNode(writer, m_systemUnitClassLib);
+
+        writer.endElement(CAEX_FILE);
+        writer.finish();
+    }
 
+    void constructAmlData(pugi::xml_node xml_ie, AMLData& amlData)
+    {
         for (pugi::xml_node xml_attr = xml_ie.child(ATTRIBUTE); xml_attr; xml_attr = xml_attr.next_sibling(ATTRIBUTE))
         {
             std::string key = xml_attr.attribute(NAME).value();
@@ -324,11 +735,10 @@ private:
             {
                 std::string value(xml_attr.child_value(VALUE));
 
-                amlData.setValue(key, value);
+                amlData.setValue(key, std::move(value));
             }
             else if (IS_VALUE_TYPE_STRING_ARRAY(xml_attr))
             {
-                vector<string> values;
                 pugi::xml_node xml_child;
                 size_t sizeOfArray = 0;
 
@@ -337,20 +747,28 @@ private:
                     sizeOfArray++;
                 }
 
-                for (size_t index = 1; index <= sizeOfArray; ++index)
+                // The names of child attribute are "1", "2", "3"... and each of them has to appear once.
+                vector<string> values(sizeOfArray);
+                vector<bool> isSet(sizeOfArray, false);
+
+                for (xml_child = xml_attr.child(ATTRIBUTE); xml_child; xml_child = xml_child.next_sibling(ATTRIBUTE))
                 {
-                    xml_child = xml_attr.find_child_by_attribute(NAME, toString(index).c_str());
-                    std::string value(xml_child.child_value(VALUE));
-                    values.push_back(value);
+                    size_t index = 0;
+                    if (!toIndex(xml_child.attribute(NAME).value(), sizeOfArray, index) || isSet[index - 1])
+                    {
+                        AML_LOG_V(ERROR, TAG, "Invalid AML : <%s> has an item of invalid name", key.c_str());
+                        throw AMLException(INVALID_AML_SCHEMA);
+                    }
+
+                    values[index - 1] = xml_child.child_value(VALUE);
+                    isSet[index - 1] = true;
                 }
 
-                amlData.setValue(key, values);
+                amlData.setValue(key, std::move(values));
             }
             else if (IS_VALUE_TYPE_MAP(xml_attr))
             {
-                AMLData value = constructAmlData(xml_attr);
-
-                amlData.setValue(key, value);
+                addAmlData(amlData, key, xml_attr);
             }
             else
             {
@@ -358,93 +776,1028 @@ private:
                 throw AMLException(INVALID_AML_SCHEMA);
             }
         }
-
-        return amlData;
     }
 
-    pugi::xml_node addInternalElement(pugi::xml_node xml_parent, const std::string suc_name)
+    bool readCaexFile(DecodeBuffer& buffer, AMLObject*& amlObj, AMLObject* target, AMLArena* arena)
     {
-        pugi::xml_node xml_suc = m_systemUnitClassLib.find_child_by_attribute(NAME, suc_name.c_str());
-        if (!xml_suc)
+        AMLReader& reader = buffer.reader;
+        if (AMLReader::Token::StartElement != reader.next() || !reader.isName(CAEX_FILE))
         {
-            AML_LOG_V(ERROR, TAG, "Invalid Data : <%s> is not present in SystemUnitClassLib", suc_name.c_str());
-            throw AMLException(NOT_MATCH_TO_AML_MODEL);
+            return false;
         }
 
-        pugi::xml_node xml_ie = xml_parent.append_copy(xml_suc);
-
-        // reset Name (SystemUnitClass -> InternalElement)
-        xml_ie.set_name(INTERNAL_ELEMENT);
-
-        // set RefBaseSystemUnitPath
-        std::string refBaseSystemUnitPath;
-        refBaseSystemUnitPath.append(m_systemUnitClassLib.attribute(NAME).value());
-        refBaseSystemUnitPath.append("/");
-        refBaseSystemUnitPath.append(suc_name);
-        xml_ie.append_attribute(REF_BASE_SYSTEM_UNIT_PATH) = refBaseSystemUnitPath.c_str();
-
-        // // set SupportedRoleClass
-        // xml_ie.append_copy(xml_suc.child(SUPPORTED_ROLE_CLASS));
-
-        return xml_ie;
+        bool hasInstanceHierarchy = false;
+        for (;;)
+        {
+            switch (reader.next())
+            {
+                case AMLReader::Token::EndElement:
+                    // Event has to be found in the first <InstanceHierarchy>, and nothing may follow <CAEXFile>.
+                    return nullptr != amlObj && AMLReader::Token::EndOfDocument == reader.next();
+                case AMLReader::Token::StartElement:
+                    if (!hasInstanceHierarchy && reader.isName(INSTANCE_HIERARCHY))
+                    {
+                        hasInstanceHierarchy = true;
+                        if (!readInstanceHierarchy(buffer, amlObj, target, arena))  return false;
+                    }
+                    else if (!reader.skipElement()) // RoleClassLib, SystemUnitClassLib, ...
+                    {
+                        return false;
+                    }
+                    break;
+                case AMLReader::Token::Text:
+                case AMLReader::Token::CData:
+                    break;
+                default:
+                    return false;
+            }
+        }
     }
 
-    void setAttributeValue(pugi::xml_node xml_ie, AMLData* amlData)
+    bool readInstanceHierarchy(DecodeBuffer& buffer, AMLObject*& amlObj, AMLObject* target, AMLArena* arena)
     {
-        for (pugi::xml_node xml_attr = xml_ie.child(ATTRIBUTE); xml_attr; xml_attr = xml_attr.next_sibling(ATTRIBUTE))
+        AMLReader& reader = buffer.reader;
+        bool hasEvent = false;
+        for (;;)
         {
-            std::string attributeName(xml_attr.attribute(NAME).value());
-
-            if(NULL != xml_attr.child(DESCRIPTION))
-            {
-                if(NULL == xml_attr.child(DESCRIPTION).next_sibling())
-                    ADD_VALUE(xml_attr, amlData->getValueToStr(attributeName));
-            }
-            else if (NULL == xml_attr.first_child()) // If <Attribute> does not have any child like <Value> or <RefSemantic>, it has a single string value.
-            {
-                ADD_VALUE(xml_attr, amlData->getValueToStr(attributeName));
-            }
-            else if (IS_VALUE_TYPE_STRING_ARRAY(xml_attr))
-            {
-                addStringArrayValue(xml_attr, amlData->getValueToStrArr(attributeName));
-            }
-            else if (IS_VALUE_TYPE_MAP(xml_attr))
-            {
-                AMLData data = amlData->getValueToAMLData(attributeName);
-                setAttributeValue(xml_attr, &data);
-            }
-            else
+            switch (reader.next())
             {
-                AML_LOG_V(ERROR, TAG, "Invalid AML : <%s> has value of invalid type", attributeName.c_str());
-                throw AMLException(INVALID_AML_SCHEMA);
+                case AMLReader::Token::EndElement:
+                    return true;
+                case AMLReader::Token::StartElement:
+                    if (!hasEvent && reader.isName(INTERNAL_ELEMENT) && reader.hasAttribute(NAME, EVENT))
+                    {
+                        hasEvent = true;
+                        if (!readEvent(buffer, amlObj, target, arena))  return false;
+                    }
+                    else if (!reader.skipElement())
+                    {
+                        return false;
+                    }
+                    break;
+                case AMLReader::Token::Text:
+                case AMLReader::Token::CData:
+                    break;
+                default:
+                    return false;
             }
         }
-
-        return;
     }
 
-    void addStringArrayValue(pugi::xml_node xml_ie, const std::vector<std::string> valueArray)
+    // AMLObject is created or target is reset when the first AMLData is read, so the ids have to precede AMLData as in the model.
+    bool readEvent(DecodeBuffer& buffer, AMLObject*& amlObj, AMLObject* target, AMLArena* arena)
     {
-        for (std::size_t i = 0, size = valueArray.size(); i != size; ++i)
-        {
-            pugi::xml_node xml_child_attr = xml_ie.append_child(ATTRIBUTE);
+        AMLReader& reader = buffer.reader;
+        bool hasData = false;
 
-            //xml_child_attr.append_attribute(NAME) = toString(i);
-            //xml_child_attr.append_attribute(ATTRIBUTE_DATA_TYPE) = xml_ie.attribute(ATTRIBUTE_DATA_TYPE).value());
-            // Copy attributes from parent node to child node
-            for (pugi::xml_attribute_iterator attrIter = xml_ie.attributes_begin(), end = xml_ie.attributes_end(); attrIter != end; ++attrIter)
+        buffer.deviceId.clear();
+        buffer.timeStamp.clear();
+        buffer.id.clear();
+
+        for (;;)
+        {
+            switch (reader.next())
             {
-                xml_child_attr.append_attribute(attrIter->name()) = attrIter->value();
+                case AMLReader::Token::EndElement:
+                    if (!hasData)
+                    {
+                        amlObj = createAmlObject(target, buffer.deviceId, buffer.timeStamp, buffer.id, arena);
+                    }
+                    return true;
+                case AMLReader::Token::StartElement:
+                    if (reader.isName(ATTRIBUTE))
+                    {
+                        reader.attribute(NAME, buffer.name);
+
+                        std::string* value = nullptr;
+                        if      (buffer.name == KEY_DEVICE)     value = &buffer.deviceId;
+                        else if (buffer.name == KEY_TIMESTAMP)  value = &buffer.timeStamp;
+                        else if (buffer.name == KEY_ID)         value = &buffer.id;
+
+                        if (nullptr == value)
+                        {
+                            if (!reader.skipElement())  return false;
+                        }
+                        else if (hasData || !readValueText(reader, *value))
+                        {
+                            return false;
+                        }
+                    }
+                    else if (reader.isName(INTERNAL_ELEMENT))
+                    {
+                        if (!hasData)
+                        {
+                            hasData = true;
+                            amlObj = createAmlObject(target, buffer.deviceId, buffer.timeStamp, buffer.id, arena);
+                        }
+
+                        reader.attribute(NAME, buffer.name);
+                        if (!readAmlData(buffer, amlObj->emplaceData(buffer.name, m_keyTable), 0))  return false;
+                    }
+                    else if (!reader.skipElement())
+                    {
+                        return false;
+                    }
+                    break;
+                case AMLReader::Token::Text:
+                case AMLReader::Token::CData:
+                    break;
+                default:
+                    return false;
             }
+        }
+    }
+
+    // reads children of <InternalElement> or <Attribute> of AMLData, same as constructAmlData()
+    bool readAmlData(DecodeBuffer& buffer, AMLData& amlData, size_t depth)
+    {
+        AMLReader& reader = buffer.reader;
+        for (;;)
+        {
+            switch (reader.next())
+            {
+                case AMLReader::Token::EndElement:
+                    return true;
+                case AMLReader::Token::StartElement:
+                    if (reader.isName(ATTRIBUTE))
+                    {
+                        if (!readAttribute(buffer, amlData, depth))     return false;
+                    }
+                    else if (!reader.skipElement())
+                    {
+                        return false;
+                    }
+                    break;
+                case AMLReader::Token::Text:
+                case AMLReader::Token::CData:
+                    break;
+                default:
+                    return false;
+            }
+        }
+    }
+
+    // Reads <Attribute> into amlData in place, with the type of value decided as constructAmlData() does:
+    // the first <Value> for string, <RefSemantic> and items for ordered list, and <Attribute>s for AMLData.
+    // The value is set as soon as its type is decided, so that its storage is reused,
+    // and returns false if a following child changes the type, which is not written by DataToAml().
+    bool readAttribute(DecodeBuffer& buffer, AMLData& amlData, size_t depth)
+    {
+        AMLReader& reader = buffer.reader;
+
+        // names of the parents are kept while children are read.
+        if (buffer.names.size() <= depth)
+        {
+            buffer.names.resize(depth + 1);
+        }
+        reader.attribute(NAME, buffer.names[depth]);
+        reader.attribute(CORRESPONDING_ATTRIBUTE_PATH, buffer.text);
+
+        bool isOrderedList = (0 == buffer.text.compare(0, strlen(ORDERED_LIST_TYPE), ORDERED_LIST_TYPE));
+        bool hasValue = false;
+        bool hasRefSemantic = false;
+        size_t itemCount = 0;
+        AMLData* data = nullptr;
+
+        for (;;)
+        {
+            switch (reader.next())
+            {
+                case AMLReader::Token::EndElement:
+                    if (hasValue || nullptr != data)
+                    {
+                        return true;
+                    }
+                    if (hasRefSemantic && !isOrderedList)
+                    {
+                        setOrderedList(buffer, amlData, buffer.names[depth], itemCount);
+                        return true;
+                    }
+                    return false;
+                case AMLReader::Token::StartElement:
+                    if (hasValue)
+                    {
+                        if (!reader.skipElement())  return false;
+                    }
+                    else if (reader.isName(VALUE))
+                    {
+                        if (hasRefSemantic || nullptr != data)  return false;
+
+                        hasValue = true;
+                        buffer.text.clear();
+                        if (!readText(reader, buffer.text))     return false;
+
+                        // copied into the storage of the value reused by AMLData
+                        amlData.setValue(buffer.names[depth], buffer.text);
+                    }
+                    else if (reader.isName(REF_SEMANTIC))
+                    {
+                        if (nullptr != data)    return false;
+
+                        hasRefSemantic = true;
+                        if (!reader.skipElement())  return false;
+                    }
+                    else if (reader.isName(ATTRIBUTE))
+                    {
+                        if (hasRefSemantic)
+                        {
+                            if (isOrderedList || !readItem(buffer, itemCount++))   return false;
+                        }
+                        else
+                        {
+                            if (nullptr == data)
+                            {
+                                data = &amlData.emplaceData(buffer.names[depth]);
+                            }
+                            if (!readAttribute(buffer, *data, depth + 1))   return false;
+                        }
+                    }
+                    else if (!reader.skipElement())
+                    {
+                        return false;
+                    }
+                    break;
+                case AMLReader::Token::Text:
+                case AMLReader::Token::CData:
+                    break;
+                default:
+                    return false;
+            }
+        }
+    }
+
+    // reads the name and the value of an item of ordered list, which are kept in the buffer until setOrderedList()
+    bool readItem(DecodeBuffer& buffer, size_t index)
+    {
+        if (buffer.items.size() <= index)
+        {
+            buffer.items.resize(index + 1);
+        }
+
+        buffer.reader.attribute(NAME, buffer.items[index].first);
+        return readValueText(buffer.reader, buffer.items[index].second);
+    }
+
+    void setOrderedList(DecodeBuffer& buffer, AMLData& amlData, const std::string& key, size_t itemCount)
+    {
+        // The names of items are "1", "2", "3"... and each of them has to appear once.
+        std::vector<std::string>& values = buffer.values;
+        std::vector<bool>& isSet = buffer.isSet;
+        values.resize(itemCount);
+        isSet.assign(itemCount, false);
+
+        for (size_t i = 0; i < itemCount; i++)
+        {
+            size_t index = 0;
+            if (!toIndex(buffer.items[i].first, itemCount, index) || isSet[index - 1])
+            {
+                throw AMLException(INVALID_AML_SCHEMA);
+            }
+
+            values[index - 1].swap(buffer.items[i].second);
+            isSet[index - 1] = true;
+        }
+
+        // copied into the storage of the value reused by AMLData
+        amlData.setValue(key, values);
+    }
+
+    // reads the text of the first <Value> of the current element as child_value(VALUE) does
+    bool readValueText(AMLReader& reader, std::string& value)
+    {
+        bool hasValue = false;
+        value.clear();
+
+        for (;;)
+        {
+            switch (reader.next())
+            {
+                case AMLReader::Token::EndElement:
+                    return true;
+                case AMLReader::Token::StartElement:
+                    if (!hasValue && reader.isName(VALUE))
+                    {
+                        hasValue = true;
+                        if (!readText(reader, value))   return false;
+                    }
+                    else if (!reader.skipElement())
+                    {
+                        return false;
+                    }
+                    break;
+                case AMLReader::Token::Text:
+                case AMLReader::Token::CData:
+                    break;
+                default:
+                    return false;
+            }
+        }
+    }
+
+    // reads the first text of the current element as child_value() does
+    bool readText(AMLReader& reader, std::string& value)
+    {
+        bool hasText = false;
+        for (;;)
+        {
+            switch (reader.next())
+            {
+                case AMLReader::Token::EndElement:
+                    return true;
+                case AMLReader::Token::StartElement:
+                    if (!reader.skipElement())  return false;
+                    break;
+                case AMLReader::Token::Text:
+                case AMLReader::Token::CData:
+                    if (!hasText)
+                    {
+                        hasText = true;
+                        reader.text(value);
+                    }
+                    break;
+                default:
+                    return false;
+            }
+        }
+    }
+
+    const SystemUnitClass& findSystemUnitClass(const std::string& suc_name)
+    {
+        std::unordered_map<std::string, SystemUnitClass>::const_iterator iter = m_systemUnitClasses.find(suc_name);
+        if (iter == m_systemUnitClasses.end())
+        {
+            AML_LOG_V(ERROR, TAG, "Invalid Data : <%s> is not present in SystemUnitClassLib", suc_name.c_str());
+            throw AMLException(NOT_MATCH_TO_AML_MODEL);
+        }
+
+        return iter->second;
+    }
+
+    // Validates the model and keeps its class libraries without "AdditionalInformation" and "InstanceHierarchy".
+    void setDocument(std::unique_ptr<pugi::xml_document> doc)
+    {
+        pugi::xml_node xmlCaexFile = doc->child(CAEX_FILE);
+        if (NULL == xmlCaexFile)
+        {
+            AML_LOG(ERROR, TAG, "Invalid AML File : <CAEXFile> does not exist");
+            throw AMLException(INVALID_AML_SCHEMA);
+        }
+
+        m_systemUnitClassLib = xmlCaexFile.child(SYSTEM_UNIT_CLASS_LIB);
+        if (NULL == m_systemUnitClassLib) 
+        {
+            AML_LOG(ERROR, TAG, "Invalid AML File : <SystemUnitClassLib> does not exist");
+            throw AMLException(INVALID_AML_SCHEMA);
+        }
+
+        m_roleClassLib = xmlCaexFile.child(ROLE_CLASS_LIB);
+        if (NULL == m_roleClassLib) 
+        {
+            AML_LOG(ERROR, TAG, "Invalid AML File : <RoleClassLib> does not exist");
+            throw AMLException(INVALID_AML_SCHEMA);
+        }
+
+        // remove "AdditionalInformation" and "InstanceHierarchy" data
+        while (xmlCaexFile.child(ADDITIONAL_INFORMATION))   xmlCaexFile.remove_child(ADDITIONAL_INFORMATION);
+        while (xmlCaexFile.child(INSTANCE_HIERARCHY))       xmlCaexFile.remove_child(INSTANCE_HIERARCHY);
+
+        m_doc = std::move(doc);
+
+        indexClasses();
+    }
+
+    // Compiles what conversions use without the document, which is kept in a compiled-model cache.
+    void compile()
+    {
+        std::vector<std::string> keys;
+        collectAttributeNames(m_systemUnitClassLib, keys);
+        collectAttributeNames(m_roleClassLib, keys);
+        m_keyTable = std::make_shared<AMLKeyTable>(std::move(keys));
+
+        compileTemplates();
+
+        m_modelId = std::string(m_systemUnitClassLib.attribute(NAME).value()) + "_" + m_systemUnitClassLib.child_value(VERSION);
+    }
+
+    // The model loaded from a cache is parsed from the AML in the cache, when the whole model is needed for the first time.
+    void ensureDocument()
+    {
+        std::call_once(m_documentOnce, [this]() {
+            if (m_doc)
+            {
+                return;
+            }
+
+            std::unique_ptr<pugi::xml_document> doc(new pugi::xml_document());
+
+            pugi::xml_parse_result result = doc->load_buffer(m_source, m_sourceSize);
+            if (pugi::status_ok != result.status)
+            {
+                AML_LOG(ERROR, TAG, "Failed to parse AML in compiled-model cache");
+                throw AMLException(INVALID_AML_SCHEMA);
+            }
+
+            setDocument(std::move(doc));
+        });
+    }
+
+    static bool readFile(const std::string& filePath, std::string& content)
+    {
+        AMLMappedFile file;
+        if (!file.open(filePath))
+        {
+            return false;
+        }
+
+        content.assign(file.data(), file.size());
+        return true;
+    }
+
+    // Cache files are named by the content hash of AML, so that a changed AML does not use the cache of the old one.
+    static std::string cacheFileName(const std::string& cacheDirPath, uint64_t sourceHash)
+    {
+        static const char HEX[] = "0123456789abcdef";
+
+        std::string filePath(cacheDirPath);
+        if (!filePath.empty() && '/' != filePath.back())
+        {
+            filePath.push_back('/');
+        }
+
+        for (int shift = 60; shift >= 0; shift -= 4)
+        {
+            filePath.push_back(HEX[(sourceHash >> shift) & 0xf]);
+        }
+        filePath.append(CACHE_FILE_EXTENSION);
+
+        return filePath;
+    }
+
+    // Layout of cache : magic, version, hash of AML, hash and size of payload, payload.
+    // Payload : AML, model id, whether Event template exists, keys, templates of SystemUnitClasses and templates of Event.
+    bool loadCache(const std::string& cacheFilePath, uint64_t sourceHash, const std::string& source)
+    {
+        if (!m_cache.open(cacheFilePath))
+        {
+            return false;
+        }
+
+        AMLCacheReader reader(m_cache.data(), m_cache.data() + m_cache.size());
+
+        const char* magic;
+        uint32_t version;
+        uint64_t hash, payloadHash, payloadSize;
+        const char* payload;
+        if (!reader.readBytes(sizeof(CACHE_MAGIC), magic) || 0 != memcmp(magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) ||
+            !reader.readU32(version) || CACHE_VERSION != version ||
+            !reader.readU64(hash) || sourceHash != hash ||
+            !reader.readU64(payloadHash) || !reader.readU64(payloadSize) || payloadSize != m_cache.size() - CACHE_HEADER_SIZE ||
+            !reader.readBytes(static_cast<size_t>(payloadSize), payload) ||
+            payloadHash != hashContent(payload, static_cast<size_t>(payloadSize)))
+        {
+            AML_LOG_V(WARNING, TAG, "Compiled-model cache is not valid : %s", cacheFilePath.c_str());
+            return false;
+        }
+
+        AMLCacheReader payloadReader(payload, payload + payloadSize);
+
+        const char* cachedSource;
+        size_t cachedSourceSize;
+        std::string modelId;
+        uint8_t hasEventTemplate;
+        uint64_t count;
+        std::vector<std::string> keys;
+        AMLTemplateMap templates;
+        AMLTemplate eventTemplate, emptyEventTemplate;
+
+        bool valid = payloadReader.readString(cachedSource, cachedSourceSize) &&
+                     cachedSourceSize == source.size() && 0 == memcmp(cachedSource, source.data(), cachedSourceSize) &&
+                     payloadReader.readString(modelId) &&
+                     payloadReader.readU8(hasEventTemplate) &&
+                     payloadReader.readU64(count) && count <= payloadSize;
+
+        for (uint64_t i = 0; valid && i < count; ++i)
+        {
+            keys.push_back(std::string());
+            valid = payloadReader.readString(keys.back());
+        }
+
+        valid = valid && payloadReader.readU64(count) && count <= payloadSize;
+        for (uint64_t i = 0; valid && i < count; ++i)
+        {
+            std::string name;
+            valid = payloadReader.readString(name) && templates[name].load(payloadReader, false);
+        }
+
+        if (!valid || !eventTemplate.load(payloadReader, true) || !emptyEventTemplate.load(payloadReader, true) || !payloadReader.atEnd())
+        {
+            AML_LOG_V(WARNING, TAG, "Compiled-model cache is not valid : %s", cacheFilePath.c_str());
+            return false;
+        }
+
+        m_source = cachedSource;
+        m_sourceSize = cachedSourceSize;
+        m_modelId = std::move(modelId);
+        m_hasEventTemplate = (0 != hasEventTemplate);
+        m_keyTable = std::make_shared<AMLKeyTable>(std::move(keys));
+        m_templates.swap(templates);
+        m_eventTemplate = std::move(eventTemplate);
+        m_emptyEventTemplate = std::move(emptyEventTemplate);
+
+        return true;
+    }
+
+    // The cache is written to a temporary file and renamed, so that other processes never map a partial one.
+    void saveCache(const std::string& cacheFilePath, uint64_t sourceHash, const std::string& source)
+    {
+        std::string payload;
+        AMLCacheWriter payloadWriter(payload);
+
+        payloadWriter.writeString(source);
+        payloadWriter.writeString(m_modelId);
+        payloadWriter.writeU8(m_hasEventTemplate ? 1 : 0);
+
+        payloadWriter.writeU64(m_keyTable->size());
+        for (unsigned int id = 0; id < m_keyTable->size(); ++id)
+        {
+            payloadWriter.writeString(m_keyTable->key(id));
+        }
+
+        payloadWriter.writeU64(m_templates.size());
+        for (const std::pair<const std::string, AMLTemplate>& entry : m_templates)
+        {
+            payloadWriter.writeString(entry.first);
+            entry.second.save(payloadWriter);
+        }
+
+        m_eventTemplate.save(payloadWriter);
+        m_emptyEventTemplate.save(payloadWriter);
+
+        std::string cache;
+        AMLCacheWriter writer(cache);
+        cache.append(CACHE_MAGIC, sizeof(CACHE_MAGIC));
+        writer.writeU32(CACHE_VERSION);
+        writer.writeU64(sourceHash);
+        writer.writeU64(hashContent(payload.data(), payload.size()));
+        writer.writeU64(payload.size());
+        cache.append(payload);
+
+        std::string tempFilePath = cacheFilePath + ".tmp" + std::to_string(reinterpret_cast<uintptr_t>(this)) +
+                                   std::to_string(std::chrono::steady_clock::now().time_since_epoch().count());
+        {
+            std::ofstream file(tempFilePath, std::ios::binary);
+            file.write(cache.data(), cache.size());
+            file.close();
+            if (file && 0 == std::rename(tempFilePath.c_str(), cacheFilePath.c_str()))
+            {
+                return;
+            }
+        }
+
+        AML_LOG_V(WARNING, TAG, "Failed to write compiled-model cache : %s", cacheFilePath.c_str());
+        std::remove(tempFilePath.c_str());
+    }
+
+    // Indexes classes by name, so that a lookup for each AMLData does not scan the model.
+    // Children of SystemUnitClassLib are found by their "Name" as find_child_by_attribute(NAME, name) does.
+    void indexClasses()
+    {
+        for (pugi::xml_node xml_suc = m_systemUnitClassLib.first_child(); xml_suc; xml_suc = xml_suc.next_sibling())
+        {
+            for (pugi::xml_attribute attr = xml_suc.first_attribute(); attr; attr = attr.next_attribute())
+            {
+                if (0 != strcmp(attr.name(), NAME) || 0 != m_systemUnitClasses.count(attr.value()))
+                {
+                    continue;
+                }
+
+                SystemUnitClass& suc = m_systemUnitClasses[attr.value()];
+                suc.node = xml_suc;
+#ifndef _DISABLE_PROTOBUF_
+                compileAttributeSchema(xml_suc, suc.attributes);
+#endif
+            }
+        }
+
+        for (pugi::xml_node xml_rc = m_roleClassLib.child(ROLE_CLASS); xml_rc; xml_rc = xml_rc.next_sibling(ROLE_CLASS))
+        {
+            m_roleClasses.insert(std::make_pair(std::string(xml_rc.attribute(NAME).value()), xml_rc));
+        }
+    }
+
+#ifndef _DISABLE_PROTOBUF_
+    void setInternalElement(datamodel::InternalElement* ie, pugi::xml_node xml_suc, const std::string& suc_name)
+    {
+        ie->set_name(xml_suc.attribute(NAME).value());
+
+        // set RefBaseSystemUnitPath, unless SystemUnitClass has its own one
+        pugi::xml_attribute xml_path = xml_suc.attribute(REF_BASE_SYSTEM_UNIT_PATH);
+        if (xml_path)
+        {
+            ie->set_refbasesystemunitpath(xml_path.value());
+        }
+        else
+        {
+            std::string refBaseSystemUnitPath;
+            refBaseSystemUnitPath.append(m_systemUnitClassLib.attribute(NAME).value());
+            refBaseSystemUnitPath.append("/");
+            refBaseSystemUnitPath.append(suc_name);
+            ie->set_refbasesystemunitpath(refBaseSystemUnitPath);
+        }
+
+        pugi::xml_node xml_src = xml_suc.child(SUPPORTED_ROLE_CLASS);
+        if (NULL != xml_src)
+        {
+            ie->mutable_supportedroleclass()->set_refroleclasspath(xml_src.attribute(REF_ROLE_CLASS_PATH).value());
+        }
+    }
+
+    // classifies <Attribute>s of xml_parent in the model, same as they were inspected for each encoding
+    static void compileAttributeSchema(pugi::xml_node xml_parent, std::vector<AttributeSchema>& schemas)
+    {
+        for (pugi::xml_node xml_attr = xml_parent.child(ATTRIBUTE); xml_attr; xml_attr = xml_attr.next_sibling(ATTRIBUTE))
+        {
+            schemas.push_back(AttributeSchema());
+            AttributeSchema& schema = schemas.back();
+            schema.node = xml_attr;
+            schema.name = xml_attr.attribute(NAME).value();
+            schema.hasValue = false;
+
+            if (NULL != xml_attr.child(DESCRIPTION))
+            {
+                schema.type = AttributeSchema::Type::Described;
+                schema.hasValue = (NULL == xml_attr.child(DESCRIPTION).next_sibling());
+            }
+            else if (NULL == xml_attr.first_child()) // If <Attribute> does not have any child like <Value> or <RefSemantic>, it has a single string value.
+            {
+                schema.type = AttributeSchema::Type::String;
+            }
+            else if (IS_VALUE_TYPE_STRING_ARRAY(xml_attr))
+            {
+                schema.type = AttributeSchema::Type::StringArray;
+            }
+            else if (IS_VALUE_TYPE_MAP(xml_attr))
+            {
+                schema.type = AttributeSchema::Type::AMLData;
+                compileAttributeSchema(xml_attr, schema.attributes);
+            }
+            else
+            {
+                schema.type = AttributeSchema::Type::Invalid;
+            }
+        }
+    }
+
+    // extracts <Attribute>s of the schemas in the model with values of amlData
+    template <typename T>
+    void extractDataAttribute(T* parent, const std::vector<AttributeSchema>& schemas, const AMLData& amlData)
+    {
+        for (const AttributeSchema& schema : schemas)
+        {
+            datamodel::Attribute* attr = parent->add_attribute();
+            setAttribute(attr, schema.node);
+
+            switch (schema.type)
+            {
+                case AttributeSchema::Type::Described:
+                    extractAttribute<datamodel::Attribute>(attr, schema.node);
+                    if (schema.hasValue)
+                        appendValue(attr, amlData.getValueToStr(schema.name));
+                    break;
+                case AttributeSchema::Type::String:
+                    appendValue(attr, amlData.getValueToStr(schema.name));
+                    break;
+                case AttributeSchema::Type::StringArray:
+                    extractAttribute<datamodel::Attribute>(attr, schema.node);
+                    addStringArrayValue(attr, schema.node, amlData.getValueToStrArr(schema.name));
+                    break;
+                case AttributeSchema::Type::AMLData:
+                    extractDataAttribute<datamodel::Attribute>(attr, schema.attributes, amlData.getValueToAMLData(schema.name));
+                    break;
+                default:
+                    AML_LOG_V(ERROR, TAG, "Invalid AML : <%s> has value of invalid type", schema.name.c_str());
+                    throw AMLException(INVALID_AML_SCHEMA);
+            }
+        }
+    }
+
+    // <Value> of AMLData follows the children of <Attribute>, so the first <Value> in the model precedes.
+    static void appendValue(datamodel::Attribute* attr, const std::string& value)
+    {
+        if (!attr->has_value())
+        {
+            attr->set_value(value);
+        }
+    }
+
+    static void addStringArrayValue(datamodel::Attribute* attr, pugi::xml_node xml_attr, const std::vector<std::string>& valueArray)
+    {
+        pugi::xml_attribute xml_name = xml_attr.attribute(NAME);
+
+        for (std::size_t i = 0, size = valueArray.size(); i != size; ++i)
+        {
+            datamodel::Attribute* attr_child = attr->add_attribute();
 
             // The names of child attribute are "1", "2", "3"...
-            xml_child_attr.attribute(NAME).set_value(i + 1);
+            attr_child->set_name(xml_name ? std::to_string(i + 1) : std::string());
+            attr_child->set_attributedatatype(attr->attributedatatype());
+            attr_child->set_value(valueArray[i]);
+        }
+
+        // As AML Document(BPR MLA, V 1.0.0), 'AttributeDataType' of the parent attribute node should be kept empty.
+        attr->set_attributedatatype("");
+    }
+#endif // _DISABLE_PROTOBUF_
+
+    // Names of <Attribute>s in the model are the keys of AMLData, which are interned by m_keyTable.
+    static void collectAttributeNames(pugi::xml_node xml_node, std::vector<std::string>& names)
+    {
+        for (pugi::xml_node xml_child = xml_node.first_child(); xml_child; xml_child = xml_child.next_sibling())
+        {
+            if (0 == strcmp(xml_child.name(), ATTRIBUTE))
+            {
+                names.push_back(xml_child.attribute(NAME).value());
+            }
+            collectAttributeNames(xml_child, names);
+        }
+    }
+
+    // Templates below produce the XML text of AMLObject without building a DOM.
+    // SystemUnitClasses are copied as <InternalElement>s with values of AMLData, same as constructCaexFile() does for protobuf.
+    void compileTemplates()
+    {
+        for (const std::pair<const std::string, SystemUnitClass>& entry : m_systemUnitClasses)
+        {
+            const std::string& suc_name = entry.first;
+            pugi::xml_node xml_suc = entry.second.node;
+            AMLTemplate& tmpl = m_templates[suc_name];
+
+            // <InternalElement> of AMLData is a child of Event. (CAEXFile/InstanceHierarchy/InternalElement)
+            tmpl.text().push_back('\n');
+            AMLWriter writer(tmpl.text(), 3);
+
+            writeStartInternalElement(writer, xml_suc, suc_name);
+            compileAttributeValue(writer, tmpl, xml_suc);
+            writer.endElement(INTERNAL_ELEMENT);
+        }
+
+        m_hasEventTemplate = (0 != m_templates.count(EVENT));
+        if (m_hasEventTemplate)
+        {
+            pugi::xml_node xml_event = m_systemUnitClasses[EVENT].node;
+
+            std::string modelXml;
+            renderModelXml(modelXml);
+
+            compileEvent(m_eventTemplate, xml_event, true);
+            m_eventTemplate.text().append(modelXml);
+
+            compileEvent(m_emptyEventTemplate, xml_event, false);
+            m_emptyEventTemplate.text().append(modelXml);
+        }
+    }
+
+    void compileEvent(AMLTemplate& tmpl, pugi::xml_node xml_event, bool hasData)
+    {
+        AMLWriter writer(tmpl.text());
+
+        writer.declaration();
+
+        writer.startElement(CAEX_FILE);
+        writer.attribute("FileName", "");
+        writer.attribute("SchemaVersion", "2.15");
+        writer.attribute("xsi:noNamespaceSchemaLocation", "CAEX_ClassModel_V2.15.xsd");
+        writer.attribute("xmlns:xsi", "http://www.w3.org/2001/XMLSchema-instance");
+
+        // add InstanceHierarchy
+        writer.startElement(INSTANCE_HIERARCHY);
+        writer.attribute(NAME, m_systemUnitClassLib.attribute(NAME).value()); // set IH name to be the same as SUCL name
+
+        // add Event as InternalElement
+        writeStartInternalElement(writer, xml_event, EVENT);
+
+        // set default attributes of Event (This has a dependency on AMLObject class..)
+        for (pugi::xml_node xml_child = xml_event.first_child(); xml_child; xml_child = xml_child.next_sibling())
+        {
+            if (pugi::node_element != xml_child.type() || 0 != strcmp(xml_child.name(), ATTRIBUTE))
+            {
+                writeNode(writer, xml_child);
+                continue;
+            }
+
+            writer.startElement(ATTRIBUTE);
+            for (pugi::xml_attribute attr = xml_child.first_attribute(); attr; attr = attr.next_attribute())
+            {
+                writer.attribute(attr.name(), attr.value());
+            }
+            for (pugi::xml_node xml_grand_child = xml_child.first_child(); xml_grand_child; xml_grand_child = xml_grand_child.next_sibling())
+            {
+                writeNode(writer, xml_grand_child);
+            }
+
+            if      (IS_NAME(xml_child, KEY_DEVICE))     compileValue(writer, tmpl, AMLTemplate::SlotType::DeviceId);
+            else if (IS_NAME(xml_child, KEY_TIMESTAMP))  compileValue(writer, tmpl, AMLTemplate::SlotType::TimeStamp);
+            else if (IS_NAME(xml_child, KEY_ID))         compileValue(writer, tmpl, AMLTemplate::SlotType::Id);
+
+            writer.endElement(ATTRIBUTE);
+        }
+
+        // add AMLDatas into Event
+        if (hasData)
+        {
+            writer.beginChildren();
+
+            // The first <InternalElement> is not indented if Event ends with a text.
+            pugi::xml_node_type lastType = xml_event.last_child().type();
+            bool isAfterText = (pugi::node_pcdata == lastType || pugi::node_cdata == lastType);
+
+            tmpl.addDataListSlot(isAfterText ? 4 : 0); // "\n\t\t\t"
+        }
+
+        writer.endElement(INTERNAL_ELEMENT);
+        writer.endElement(INSTANCE_HIERARCHY);
+    }
+
+    void writeNode(AMLWriter& writer, pugi::xml_node xml_node)
+    {
+        switch (xml_node.type())
+        {
+            case pugi::node_element:
+                writer.startElement(xml_node.name());
+                for (pugi::xml_attribute attr = xml_node.first_attribute(); attr; attr = attr.next_attribute())
+                {
+                    writer.attribute(attr.name(), attr.value());
+                }
+                for (pugi::xml_node xml_child = xml_node.first_child(); xml_child; xml_child = xml_child.next_sibling())
+                {
+                    writeNode(writer, xml_child);
+                }
+                writer.endElement(xml_node.name());
+                break;
+            case pugi::node_pcdata:
+                writer.text(xml_node.value());
+                break;
+            case pugi::node_cdata:
+                writer.cdata(xml_node.value());
+                break;
+            default: // other types are not loaded with default parse options
+                break;
+        }
+    }
+
+    void writeStartInternalElement(AMLWriter& writer, pugi::xml_node xml_suc, const std::string& suc_name)
+    {
+        writer.startElement(INTERNAL_ELEMENT);
+        for (pugi::xml_attribute attr = xml_suc.first_attribute(); attr; attr = attr.next_attribute())
+        {
+            writer.attribute(attr.name(), attr.value());
+        }
+
+        std::string refBaseSystemUnitPath;
+        refBaseSystemUnitPath.append(m_systemUnitClassLib.attribute(NAME).value());
+        refBaseSystemUnitPath.append("/");
+        refBaseSystemUnitPath.append(suc_name);
+        writer.attribute(REF_BASE_SYSTEM_UNIT_PATH, refBaseSystemUnitPath.c_str());
+    }
+
+    void compileValue(AMLWriter& writer, AMLTemplate& tmpl, AMLTemplate::SlotType type, const std::string& key = "")
+    {
+        writer.startElement(VALUE);
+        writer.text("");
+        tmpl.addSlot(type, key);
+        writer.endElement(VALUE);
+    }
+
+    // compiles children of xml_parent with slots for values of <Attribute>s, same as extractDataAttribute()
+    void compileAttributeValue(AMLWriter& writer, AMLTemplate& tmpl, pugi::xml_node xml_parent)
+    {
+        for (pugi::xml_node xml_attr = xml_parent.first_child(); xml_attr; xml_attr = xml_attr.next_sibling())
+        {
+            if (pugi::node_element != xml_attr.type() || 0 != strcmp(xml_attr.name(), ATTRIBUTE))
+            {
+                writeNode(writer, xml_attr);
+                continue;
+            }
+
+            std::string attributeName(xml_attr.attribute(NAME).value());
+
+            if (NULL != xml_attr.child(DESCRIPTION))
+            {
+                if (NULL == xml_attr.child(DESCRIPTION).next_sibling())
+                {
+                    compileStringValue(writer, tmpl, xml_attr, attributeName);
+                }
+                else
+                {
+                    writeNode(writer, xml_attr);
+                }
+            }
+            else if (NULL == xml_attr.first_child()) // If <Attribute> does not have any child like <Value> or <RefSemantic>, it has a single string value.
+            {
+                compileStringValue(writer, tmpl, xml_attr, attributeName);
+            }
+            else if (IS_VALUE_TYPE_STRING_ARRAY(xml_attr))
+            {
+                compileStringArrayValue(writer, tmpl, xml_attr, attributeName);
+            }
+            else if (IS_VALUE_TYPE_MAP(xml_attr))
+            {
+                writer.startElement(ATTRIBUTE);
+                for (pugi::xml_attribute attr = xml_attr.first_attribute(); attr; attr = attr.next_attribute())
+                {
+                    writer.attribute(attr.name(), attr.value());
+                }
+
+                tmpl.beginDataScope(attributeName);
+                compileAttributeValue(writer, tmpl, xml_attr);
+                tmpl.endDataScope();
+
+                writer.endElement(ATTRIBUTE);
+            }
+            else
+            {
+                // AMLException is thrown on render, as AMLData of this SystemUnitClass can not be converted.
+                tmpl.addSlot(AMLTemplate::SlotType::Invalid, attributeName);
+            }
+        }
+    }
 
-            ADD_VALUE(xml_child_attr, valueArray[i]);
+    void compileStringValue(AMLWriter& writer, AMLTemplate& tmpl, pugi::xml_node xml_attr, const std::string& key)
+    {
+        writer.startElement(ATTRIBUTE);
+        for (pugi::xml_attribute attr = xml_attr.first_attribute(); attr; attr = attr.next_attribute())
+        {
+            writer.attribute(attr.name(), attr.value());
+        }
+        for (pugi::xml_node xml_child = xml_attr.first_child(); xml_child; xml_child = xml_child.next_sibling())
+        {
+            writeNode(writer, xml_child);
         }
 
-        // As AML Document(BPR MLA, V 1.0.0), 'AttributeDataType' of the parent attribute node should be kept empty.
-        xml_ie.attribute(ATTRIBUTE_DATA_TYPE).set_value("");
+        compileValue(writer, tmpl, AMLTemplate::SlotType::String, key);
+
+        writer.endElement(ATTRIBUTE);
+    }
+
+    void compileStringArrayValue(AMLWriter& writer, AMLTemplate& tmpl, pugi::xml_node xml_attr, const std::string& key)
+    {
+        pugi::xml_attribute xml_name = xml_attr.attribute(NAME);
+        pugi::xml_attribute xml_type = xml_attr.attribute(ATTRIBUTE_DATA_TYPE);
+        std::string& text = tmpl.text();
+
+        writer.startElement(ATTRIBUTE);
+        for (pugi::xml_attribute attr = xml_attr.first_attribute(); attr; attr = attr.next_attribute())
+        {
+            // As AML Document(BPR MLA, V 1.0.0), 'AttributeDataType' of the parent attribute node should be kept empty.
+            writer.attribute(attr.name(), (attr == xml_type) ? "" : attr.value());
+        }
+        for (pugi::xml_node xml_child = xml_attr.first_child(); xml_child; xml_child = xml_child.next_sibling())
+        {
+            writeNode(writer, xml_child);
+        }
+
+        // Child attributes are rendered twice with empty name and value, and cut out as the text of an item.
+        // The first one differs from the others only if it follows a text, which is not indented.
+        size_t firstBegin = text.size();
+        size_t secondBegin = 0, indexOffset = 0, valueOffset = 0;
+
+        for (int i = 0; i < 2; ++i)
+        {
+            secondBegin = text.size();
+
+            writer.startElement(ATTRIBUTE);
+            for (pugi::xml_attribute attr = xml_attr.first_attribute(); attr; attr = attr.next_attribute())
+            {
+                if (attr == xml_name)
+                {
+                    // The names of child attribute are "1", "2", "3"...
+                    writer.attribute(attr.name(), "");
+                    indexOffset = text.size() - 1;
+                }
+                else
+                {
+                    writer.attribute(attr.name(), attr.value());
+                }
+            }
+            writer.startElement(VALUE);
+            writer.text("");
+            valueOffset = text.size();
+            writer.endElement(VALUE);
+            writer.endElement(ATTRIBUTE);
+        }
+
+        if (!xml_name)
+        {
+            indexOffset = valueOffset; // not rendered, as getValueToStrArr() throws with an empty key
+        }
+
+        std::string itemText(text, secondBegin);
+        size_t leadLength = itemText.size() - (secondBegin - firstBegin);
+
+        text.resize(firstBegin);
+        tmpl.addArraySlot(key, itemText, indexOffset - secondBegin, valueOffset - secondBegin, leadLength);
+
+        writer.endElement(ATTRIBUTE);
     }
 };
 
@@ -452,6 +1805,18 @@ Representation::Representation(const std::string amlFilePath) : m_amlModel (new
 {
 }
 
+Representation::Representation(const std::string amlFilePath, const std::string cacheDirPath) : m_amlModel (new AMLModel(amlFilePath, cacheDirPath))
+{
+}
+
+Representation::Representation(const char* amlBuffer, size_t size) : m_amlModel (new AMLModel(amlBuffer, size, false))
+{
+}
+
+Representation::Representation(char* amlBuffer, size_t size, bool parseInPlace) : m_amlModel (new AMLModel(amlBuffer, size, parseInPlace))
+{
+}
+
 Representation::~Representation(void)
 {
     delete m_amlModel;
@@ -469,21 +1834,82 @@ AMLObject* Representation::getConfigInfo() const
 
 std::string Representation::DataToAml(const AMLObject& amlObject) const
 {
-    pugi::xml_document* xml_doc = m_amlModel->constructXmlDoc(amlObject);
-    assert(nullptr != xml_doc);
+    std::string xmlStr;
+    DataToAml(amlObject, xmlStr);
 
-    m_amlModel->appendModel(xml_doc);
+    return xmlStr;
+}
 
-    std::ostringstream stream;
-    xml_doc->save(stream);
+void Representation::DataToAml(const AMLObject& amlObject, std::string& out) const
+{
+    size_t size = out.size();
+    try
+    {
+        m_amlModel->writeXml(amlObject, out);
+    }
+    catch (const AMLException&)
+    {
+        out.resize(size);
+        throw;
+    }
+}
 
-    delete xml_doc;
+AMLObject* Representation::AmlToData(const std::string& xmlStr) const
+{
+    return amlToData(xmlStr, nullptr, nullptr);
+}
 
-    return stream.str();
+AMLObject* Representation::AmlToData(const std::string& xmlStr, AMLArena& arena) const
+{
+    return amlToData(xmlStr, nullptr, &arena);
 }
 
-AMLObject* Representation::AmlToData(const std::string& xmlStr) const
+AMLObject* Representation::AmlToData(char* buffer, size_t size) const
+{
+    return amlToData(buffer, size, nullptr, nullptr);
+}
+
+AMLObject* Representation::AmlToData(char* buffer, size_t size, AMLArena& arena) const
+{
+    return amlToData(buffer, size, nullptr, &arena);
+}
+
+AMLObject* Representation::ByteToData(const std::string& byte) const
+{
+    return byteToData(byte, nullptr, nullptr);
+}
+
+AMLObject* Representation::ByteToData(const std::string& byte, AMLArena& arena) const
+{
+    return byteToData(byte, nullptr, &arena);
+}
+
+void Representation::AmlToData(const std::string& xmlStr, AMLObject& amlObject) const
+{
+    amlToData(xmlStr, &amlObject, nullptr);
+}
+
+void Representation::AmlToData(char* buffer, size_t size, AMLObject& amlObject) const
+{
+    amlToData(buffer, size, &amlObject, nullptr);
+}
+
+void Representation::ByteToData(const std::string& byte, AMLObject& amlObject) const
+{
+    byteToData(byte, &amlObject, nullptr);
+}
+
+AMLObject* Representation::amlToData(const std::string& xmlStr, AMLObject* target, AMLArena* arena) const
 {
+    // load_string() reads until a null character
+    const char* xml = xmlStr.c_str();
+
+    AMLObject *amlObj = m_amlModel->readAmlObject(xml, xml + strlen(xml), target, arena);
+    if (nullptr != amlObj)
+    {
+        return amlObj;
+    }
+
     pugi::xml_document dataXml;
     pugi::xml_parse_result result = dataXml.load_string(xmlStr.c_str());
     if (pugi::status_ok != result.status)
@@ -492,161 +1918,283 @@ AMLObject* Representation::AmlToData(const std::string& xmlStr) const
         throw AMLException(INVALID_XML_STR);
     }
 
-    AMLObject *amlObj = m_amlModel->constructAmlObject(&dataXml);
+    amlObj = m_amlModel->constructAmlObject(&dataXml, target, arena);
     assert(nullptr != amlObj);
     return amlObj;
 }
 
-AMLObject* Representation::ByteToData(const std::string& byte) const
+AMLObject* Representation::amlToData(char* buffer, size_t size, AMLObject* target, AMLArena* arena) const
+{
+    if (NULL == buffer)
+    {
+        AML_LOG(ERROR, TAG, "Buffer is null");
+        throw AMLException(INVALID_PARAM);
+    }
+
+    AMLObject *amlObj = m_amlModel->readAmlObject(buffer, buffer + size, target, arena);
+    if (nullptr != amlObj)
+    {
+        return amlObj;
+    }
+
+    pugi::xml_document dataXml;
+    pugi::xml_parse_result result = dataXml.load_buffer_inplace(buffer, size);
+    if (pugi::status_ok != result.status)
+    {
+        AML_LOG(ERROR, TAG, "Failed to load buffer : Invalid XML");
+        throw AMLException(INVALID_XML_STR);
+    }
+
+    amlObj = m_amlModel->constructAmlObject(&dataXml, target, arena);
+    assert(nullptr != amlObj);
+    return amlObj;
+}
+
+AMLObject* Representation::byteToData(const std::string& byte, AMLObject* target, AMLArena* arena) const
 {
 #ifdef _DISABLE_PROTOBUF_
     (void)byte;
+    (void)target;
+    (void)arena;
     AML_LOG(ERROR, TAG, "ByteToData() is not supported. ('disable_protobuf' build option is enabled)");
     throw AMLException(API_NOT_ENABLED);
 #else
-    datamodel::CAEXFile* caex = new datamodel::CAEXFile();
+    ThreadCaexFile threadCaex;
+    datamodel::CAEXFile& caex = threadCaex.get();
+    threadCaex.setByteSize(byte.size());
 
-    if (false == caex->ParseFromString(byte))
+    if (false == caex.ParseFromString(byte))
     {
         AML_LOG(ERROR, TAG, "Failed to parse from string : Invalid byte");
-        delete caex;
         throw AMLException(INVALID_BYTE_STR);
     }
 
-    pugi::xml_document* xml_doc = m_amlModel->constructXmlDoc();
-    assert(nullptr != xml_doc);
-
-    // update CAEX attributes
-    pugi::xml_node xml_caex = xml_doc->child(CAEX_FILE);
-    xml_caex.attribute("FileName")                      = caex->filename().c_str();
-    xml_caex.attribute("SchemaVersion")                 = caex->schemaversion().c_str();
-    xml_caex.attribute("xsi:noNamespaceSchemaLocation") = caex->xsi().c_str();
-    xml_caex.attribute("xmlns:xsi")                     = caex->xmlns().c_str();
-
-    for (datamodel::InstanceHierarchy ih : caex->instancehierarchy())
-    {
-        pugi::xml_node xml_ih = xml_caex.append_child(INSTANCE_HIERARCHY);
-        VERIFY_NON_NULL_THROW_EXCEPTION(xml_ih);
-
-        xml_ih.append_attribute(NAME) = ih.name().c_str();
-
-        extractProtoInternalElement(xml_ih, &ih);
-    }
-
-    caex->clear_instancehierarchy();
-    delete caex;
-
-    AMLObject* amlObj = m_amlModel->constructAmlObject(xml_doc);
+    AMLObject* amlObj = m_amlModel->constructAmlObject(caex, target, arena);
     assert(nullptr != amlObj);
 
-    delete xml_doc;
-
     return amlObj;
 #endif // _DISABLE_PROTOBUF_
 }
 
 std::string Representation::DataToByte(const AMLObject& amlObject) const
+{
+    std::string binary;
+    DataToByte(amlObject, binary);
+
+    return binary;
+}
+
+void Representation::DataToByte(const AMLObject& amlObject, std::string& out) const
 {
 #ifdef _DISABLE_PROTOBUF_
     (void)amlObject;
+    (void)out;
     AML_LOG(ERROR, TAG, "DataToByte() is not supported. ('disable_protobuf' build option is enabled)");
     throw AMLException(API_NOT_ENABLED);
 #else
-    // convert AMLObject to XML object
-    pugi::xml_document* xml_doc = m_amlModel->constructXmlDoc(amlObject);
-    assert(nullptr != xml_doc);
-
-    // convert XML object to AML proto object
-    pugi::xml_node xml_caex = xml_doc->child(CAEX_FILE);
-    
-    datamodel::CAEXFile* caex = new datamodel::CAEXFile();
-
-    caex->set_filename(xml_caex.attribute("FileName").value());
-    caex->set_schemaversion(xml_caex.attribute("SchemaVersion").value());
-    caex->set_xsi(xml_caex.attribute("xsi:noNamespaceSchemaLocation").value());
-    caex->set_xmlns(xml_caex.attribute("xmlns:xsi").value());
+    ThreadCaexFile threadCaex;
+    datamodel::CAEXFile& caex = threadCaex.get();
+    caex.Clear();
+    m_amlModel->constructCaexFile(amlObject, &caex);
+
+    // serialized directly after the existing contents, within the capacity of out if it is enough
+    size_t size = out.size();
+    if (false == caex.AppendToString(&out))
+    {
+        out.resize(size);
+        throw AMLException(SERIALIZE_FAIL);
+    }
+    threadCaex.setByteSize(out.size() - size);
+#endif // _DISABLE_PROTOBUF_
+}
 
-    for (pugi::xml_node xml_ih = xml_caex.child(INSTANCE_HIERARCHY); xml_ih; xml_ih = xml_ih.next_sibling(INSTANCE_HIERARCHY))
+// Calls convert() with each index of [0, count), in order or on the threads of pool.
+// Returns the smallest index whose conversion failed with its exception of any type (e.g. std::bad_alloc), or count if none failed.
+// All the items before the failed one are converted, and the items after it may be skipped.
+template <typename Convert>
+static size_t runBatch(size_t count, AMLWorkerPool* pool, Convert convert, std::exception_ptr& error)
+{
+    if (nullptr == pool)
     {
-        datamodel::InstanceHierarchy* ih = caex->add_instancehierarchy();
+        for (size_t index = 0; index < count; ++index)
+        {
+            try
+            {
+                convert(index);
+            }
+            catch (...)
+            {
+                error = std::current_exception();
+                return index;
+            }
+        }
+        return count;
+    }
 
-        ih->set_name    (xml_ih.attribute(NAME).value());
-      //ih->set_version (xml_ih.child_value(VERSION)); // @TODO: required?
+    std::mutex mutex;
+    std::atomic<size_t> failed(count);
+    pool->run(count, [&](size_t index) {
+        if (index > failed)
+        {
+            return;
+        }
 
-        extractInternalElement<datamodel::InstanceHierarchy>(ih, xml_ih);
-    }
+        try
+        {
+            convert(index);
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (index < failed)
+            {
+                failed = index;
+                error = std::current_exception();
+            }
+        }
+    });
 
-    delete xml_doc;
+    return failed;
+}
 
-    std::string binary;
-    bool isSuccess = caex->SerializeToString(&binary);
+// Converts AMLObjects into the strings of out, which are reused.
+// If an exception is thrown, out is shrunk to the results before the failed AMLObject.
+template <typename Encode>
+static void encodeBatch(const std::vector<AMLObject>& amlObjects, std::vector<std::string>& out, AMLWorkerPool* pool, Encode encode)
+{
+    out.resize(amlObjects.size());
 
-    caex->clear_instancehierarchy();
-    delete caex;
+    std::exception_ptr error;
+    size_t failed = runBatch(amlObjects.size(), pool, [&](size_t index) {
+        out[index].clear();
+        encode(amlObjects[index], out[index]);
+    }, error);
 
-    if (false == isSuccess)
+    if (failed != amlObjects.size())
     {
-        throw AMLException(SERIALIZE_FAIL);
+        out.resize(failed);
+        std::rethrow_exception(error);
     }
-    return binary;
-#endif // _DISABLE_PROTOBUF_
 }
 
-#ifndef _DISABLE_PROTOBUF_
-template <typename T>
-static void extractProtoAttribute(pugi::xml_node xmlNode, T* attr)
+// Converts inputs into AMLObjects of out, which are reused, and new ones are appended if out is shorter.
+// If an exception is thrown, out is shrunk to the results before the failed input.
+template <typename Decode>
+static void decodeBatch(const std::vector<std::string>& inputs, std::vector<AMLObject>& out, AMLWorkerPool* pool, Decode decode)
 {
-    for (datamodel::Attribute att : attr->attribute())
-    {
-        pugi::xml_node xml_attr = xmlNode.append_child(ATTRIBUTE);
-        VERIFY_NON_NULL_THROW_EXCEPTION(xml_attr);
-
-        xml_attr.append_attribute(NAME) = att.name().c_str();
-        xml_attr.append_attribute(ATTRIBUTE_DATA_TYPE) = att.attributedatatype().c_str();
-
-        extractProtoAttribute(xml_attr, &att);
+    // AMLObjects are created out of out, so that out is not resized during the batch.
+    size_t reused = std::min(inputs.size(), out.size());
+    std::vector<std::unique_ptr<AMLObject>> created(inputs.size() - reused);
 
-        if (att.has_value())
+    std::exception_ptr error;
+    size_t failed = runBatch(inputs.size(), pool, [&](size_t index) {
+        if (index < reused)
         {
-            xml_attr.append_child(VALUE).text().set(att.value().c_str());
+            decode(inputs[index], &out[index]);
         }
-        if (att.has_refsemantic())
+        else
         {
-            pugi::xml_node xml_refsemantic = xml_attr.append_child(REF_SEMANTIC);
-            xml_refsemantic.append_attribute(CORRESPONDING_ATTRIBUTE_PATH) = att.refsemantic().correspondingattributepath().c_str();
+            created[index - reused].reset(decode(inputs[index], nullptr));
         }
+    }, error);
+
+    out.erase(out.begin() + std::min(reused, failed), out.end());
+    for (size_t index = reused; index < failed; ++index)
+    {
+        out.push_back(std::move(*created[index - reused]));
     }
 
-    return;
+    if (failed != inputs.size())
+    {
+        std::rethrow_exception(error);
+    }
 }
 
-template <typename T>
-static void extractProtoInternalElement(pugi::xml_node xmlNode, T* ie)
+void Representation::DataToAml(const std::vector<AMLObject>& amlObjects, std::vector<std::string>& out) const
 {
-    for (datamodel::InternalElement sie : ie->internalelement())
-    {
-        pugi::xml_node xml_ie = xmlNode.append_child(INTERNAL_ELEMENT);
-        VERIFY_NON_NULL_THROW_EXCEPTION(xml_ie);
+    dataToAml(amlObjects, out, nullptr);
+}
 
-        xml_ie.append_attribute(NAME) = sie.name().c_str();
-        xml_ie.append_attribute(REF_BASE_SYSTEM_UNIT_PATH) = sie.refbasesystemunitpath().c_str();
+void Representation::DataToAml(const std::vector<AMLObject>& amlObjects, std::vector<std::string>& out, AMLWorkerPool& pool) const
+{
+    dataToAml(amlObjects, out, &pool);
+}
 
-        extractProtoAttribute(xml_ie, &sie);
-        extractProtoInternalElement(xml_ie, &sie);
+void Representation::AmlToData(const std::vector<std::string>& xmlStrs, std::vector<AMLObject>& out) const
+{
+    amlToData(xmlStrs, out, nullptr);
+}
 
-        if (nullptr != &sie.supportedroleclass() && 
-            nullptr != &sie.supportedroleclass().refroleclasspath())
-        {
-            pugi::xml_node xml_src = xml_ie.append_child(SUPPORTED_ROLE_CLASS);
-            VERIFY_NON_NULL_THROW_EXCEPTION(xml_src);
+void Representation::AmlToData(const std::vector<std::string>& xmlStrs, std::vector<AMLObject>& out, AMLWorkerPool& pool) const
+{
+    amlToData(xmlStrs, out, &pool);
+}
 
-            xml_src.append_attribute(REF_ROLE_CLASS_PATH) = sie.supportedroleclass().refroleclasspath().c_str();
-        }
-    }
+void Representation::DataToByte(const std::vector<AMLObject>& amlObjects, std::vector<std::string>& out) const
+{
+    dataToByte(amlObjects, out, nullptr);
+}
 
-    return;
+void Representation::DataToByte(const std::vector<AMLObject>& amlObjects, std::vector<std::string>& out, AMLWorkerPool& pool) const
+{
+    dataToByte(amlObjects, out, &pool);
+}
+
+void Representation::ByteToData(const std::vector<std::string>& bytes, std::vector<AMLObject>& out) const
+{
+    byteToData(bytes, out, nullptr);
+}
+
+void Representation::ByteToData(const std::vector<std::string>& bytes, std::vector<AMLObject>& out, AMLWorkerPool& pool) const
+{
+    byteToData(bytes, out, &pool);
+}
+
+void Representation::dataToAml(const std::vector<AMLObject>& amlObjects, std::vector<std::string>& out, AMLWorkerPool* pool) const
+{
+    encodeBatch(amlObjects, out, pool, [this](const AMLObject& amlObject, std::string& xmlStr) {
+        m_amlModel->writeXml(amlObject, xmlStr);
+    });
+}
+
+void Representation::amlToData(const std::vector<std::string>& xmlStrs, std::vector<AMLObject>& out, AMLWorkerPool* pool) const
+{
+    decodeBatch(xmlStrs, out, pool, [this](const std::string& xmlStr, AMLObject* target) {
+        return amlToData(xmlStr, target, nullptr);
+    });
+}
+
+void Representation::dataToByte(const std::vector<AMLObject>& amlObjects, std::vector<std::string>& out, AMLWorkerPool* pool) const
+{
+#ifdef _DISABLE_PROTOBUF_
+    (void)amlObjects;
+    (void)out;
+    (void)pool;
+    AML_LOG(ERROR, TAG, "DataToByte() is not supported. ('disable_protobuf' build option is enabled)");
+    throw AMLException(API_NOT_ENABLED);
+#else
+    encodeBatch(amlObjects, out, pool, [this](const AMLObject& amlObject, std::string& binary) {
+        DataToByte(amlObject, binary);
+    });
+#endif // _DISABLE_PROTOBUF_
+}
+
+void Representation::byteToData(const std::vector<std::string>& bytes, std::vector<AMLObject>& out, AMLWorkerPool* pool) const
+{
+#ifdef _DISABLE_PROTOBUF_
+    (void)bytes;
+    (void)out;
+    (void)pool;
+    AML_LOG(ERROR, TAG, "ByteToData() is not supported. ('disable_protobuf' build option is enabled)");
+    throw AMLException(API_NOT_ENABLED);
+#else
+    decodeBatch(bytes, out, pool, [this](const std::string& byte, AMLObject* target) {
+        return byteToData(byte, target, nullptr);
+    });
+#endif // _DISABLE_PROTOBUF_
 }
 
+#ifndef _DISABLE_PROTOBUF_
 template <typename T>
 static void extractAttribute(T* attr, pugi::xml_node xmlNode)
 {
@@ -654,25 +2202,30 @@ static void extractAttribute(T* attr, pugi::xml_node xmlNode)
     {
         datamodel::Attribute* attr_child = attr->add_attribute();
 
-        attr_child->set_name              (xmlAttr.attribute(NAME).value());
-        attr_child->set_attributedatatype (xmlAttr.attribute(ATTRIBUTE_DATA_TYPE).value());
-        //attr->set_description       (xmlAttr.child_value(DESCRIPTION)); //@TODO: required?
+        setAttribute(attr_child, xmlAttr);
 
         extractAttribute<datamodel::Attribute>(attr_child, xmlAttr);
+    }
 
-        pugi::xml_node xmlValue = xmlAttr.child(VALUE);
-        if (NULL != xmlValue)
-        {
-            attr_child->set_value(xmlValue.text().as_string());
-        }
+    return;
+}
 
-        pugi::xml_node xmlRefSemantic = xmlAttr.child(REF_SEMANTIC);
-        if (NULL != xmlRefSemantic)
-        {
-            datamodel::RefSemantic* refSemantic = new datamodel::RefSemantic();
-            refSemantic->set_correspondingattributepath(xmlRefSemantic.attribute(CORRESPONDING_ATTRIBUTE_PATH).value());
-            attr_child->set_allocated_refsemantic(refSemantic);
-        }
+static void setAttribute(datamodel::Attribute* attr, pugi::xml_node xmlAttr)
+{
+    attr->set_name              (xmlAttr.attribute(NAME).value());
+    attr->set_attributedatatype (xmlAttr.attribute(ATTRIBUTE_DATA_TYPE).value());
+    //attr->set_description       (xmlAttr.child_value(DESCRIPTION)); //@TODO: required?
+
+    pugi::xml_node xmlValue = xmlAttr.child(VALUE);
+    if (NULL != xmlValue)
+    {
+        attr->set_value(xmlValue.text().as_string());
+    }
+
+    pugi::xml_node xmlRefSemantic = xmlAttr.child(REF_SEMANTIC);
+    if (NULL != xmlRefSemantic)
+    {
+        attr->mutable_refsemantic()->set_correspondingattributepath(xmlRefSemantic.attribute(CORRESPONDING_ATTRIBUTE_PATH).value());
     }
 
     return;
@@ -694,10 +2247,7 @@ static void extractInternalElement(T* ie, pugi::xml_node xmlNode)
         pugi::xml_node xmlSrc = xmlIe.child(SUPPORTED_ROLE_CLASS);
         if (NULL != xmlSrc)
         {
-            datamodel::SupportedRoleClass* src = new datamodel::SupportedRoleClass();
-            src->set_refroleclasspath(xmlSrc.attribute(REF_ROLE_CLASS_PATH).value());
-
-            ie_child->set_allocated_supportedroleclass(src);
+            ie_child->mutable_supportedroleclass()->set_refroleclasspath(xmlSrc.attribute(REF_ROLE_CLASS_PATH).value());
         }
     }
 
@@ -0,0 +1,216 @@
+/*******************************************************************************
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *******************************************************************************/
+
+#include <cstdlib>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "AMLGenerator.h"
+#include "AMLException.h"
+
+using namespace std;
+using namespace AML;
+
+static const char EVENT[] = "Event";
+
+static void writeAttribute(ostringstream& xml, const string& indent, const string& name)
+{
+    xml << indent << "<Attribute Name=\"" << name << "\" AttributeDataType=\"xs:string\"/>\n";
+}
+
+// writes a nested attribute, whose levels have "v" and the next level "n"
+static void writeNestedAttribute(ostringstream& xml, const string& indent, const string& name, size_t depth)
+{
+    xml << indent << "<Attribute Name=\"" << name << "\" AttributeDataType=\"xs:string\">\n";
+    writeAttribute(xml, indent + "\t", "v");
+    if (depth > 1)
+    {
+        writeNestedAttribute(xml, indent + "\t", "n", depth - 1);
+    }
+    xml << indent << "</Attribute>\n";
+}
+
+AMLGenerator::AMLGenerator(const AMLGeneratorConfig& config)
+ : m_config(config), m_random(config.seed), m_timeStamp(0)
+{
+    if ((0 != m_config.nestedAttributeCount && 0 == m_config.nestingDepth) ||
+        (0 != m_config.orderedListCount && 0 == m_config.listLength) ||
+        m_config.deviceId.empty())
+    {
+        throw AMLException(INVALID_PARAM);
+    }
+
+    for (size_t i = 0; i < m_config.systemUnitClassCount; ++i)
+    {
+        m_dataNames.push_back("Unit" + to_string(i));
+    }
+    for (size_t i = 0; i < m_config.attributeCount; ++i)
+    {
+        m_attributeNames.push_back("s" + to_string(i));
+    }
+}
+
+const AMLGeneratorConfig& AMLGenerator::config() const
+{
+    return m_config;
+}
+
+string AMLGenerator::model() const
+{
+    // RoleClass attributes have fixed values, so that the model does not depend on the seed.
+    ostringstream xml;
+    xml << "<?xml version=\"1.0\" encoding=\"utf-8\"?>\n"
+        << "<CAEXFile FileName=\"\" SchemaVersion=\"2.15\" xsi:noNamespaceSchemaLocation=\"CAEX_Classmodel_V2.15.xsd\""
+        << " xmlns:xsi=\"http://www.w3.org/2001/XMLSchema-instance\">\n"
+        << "\t<InstanceHierarchy Name=\"GEN_Model\">\n"
+        << "\t</InstanceHierarchy>\n"
+        << "\t<RoleClassLib Name=\"" << m_config.deviceId << "\">\n"
+        << "\t\t<Version>1.0.0</Version>\n";
+
+    vector<string> roleClassNames(m_dataNames);
+    for (size_t i = 0; i < m_config.extraRoleClassCount; ++i)
+    {
+        roleClassNames.push_back("Role" + to_string(i));
+    }
+    for (const string& name : roleClassNames)
+    {
+        xml << "\t\t<RoleClass Name=\"" << name << "\">\n";
+        for (size_t i = 0; i < m_config.roleClassAttributeCount; ++i)
+        {
+            xml << "\t\t\t<Attribute Name=\"c" << i << "\" AttributeDataType=\"xs:string\">\n"
+                << "\t\t\t\t<Value>" << (i + 1) * 10 << "</Value>\n"
+                << "\t\t\t</Attribute>\n";
+        }
+        xml << "\t\t</RoleClass>\n";
+    }
+
+    xml << "\t</RoleClassLib>\n"
+        << "\t<SystemUnitClassLib Name=\"GEN_Model\">\n"
+        << "\t\t<Version>0.0.1</Version>\n"
+        << "\t\t<SystemUnitClass Name=\"" << EVENT << "\">\n";
+    writeAttribute(xml, "\t\t\t", "device");
+    writeAttribute(xml, "\t\t\t", "id");
+    writeAttribute(xml, "\t\t\t", "timestamp");
+    xml << "\t\t</SystemUnitClass>\n";
+
+    for (const string& name : m_dataNames)
+    {
+        xml << "\t\t<SystemUnitClass Name=\"" << name << "\">\n";
+        for (const string& attributeName : m_attributeNames)
+        {
+            writeAttribute(xml, "\t\t\t", attributeName);
+        }
+        for (size_t i = 0; i < m_config.nestedAttributeCount; ++i)
+        {
+            writeNestedAttribute(xml, "\t\t\t", "nested" + to_string(i), m_config.nestingDepth);
+        }
+        for (size_t i = 0; i < m_config.orderedListCount; ++i)
+        {
+            xml << "\t\t\t<Attribute Name=\"list" << i << "\" AttributeDataType=\"xs:string\">\n"
+                << "\t\t\t\t<RefSemantic CorrespondingAttributePath=\"OrderedListType\"/>\n"
+                << "\t\t\t</Attribute>\n";
+        }
+        xml << "\t\t</SystemUnitClass>\n";
+    }
+
+    xml << "\t</SystemUnitClassLib>\n"
+        << "</CAEXFile>\n";
+
+    return xml.str();
+}
+
+void AMLGenerator::writeModel(const string& filePath) const
+{
+    ofstream file(filePath, ios::binary);
+    file << model();
+    file.close();
+    if (!file)
+    {
+        throw AMLException(INVALID_FILE_PATH);
+    }
+}
+
+vector<string> AMLGenerator::dataNames() const
+{
+    return m_dataNames;
+}
+
+AMLObject AMLGenerator::event()
+{
+    AMLObject amlObj(m_config.deviceId, to_string(++m_timeStamp));
+
+    for (const string& name : m_dataNames)
+    {
+        AMLData data;
+        for (const string& attributeName : m_attributeNames)
+        {
+            data.setValue(attributeName, randomValue());
+        }
+        for (size_t i = 0; i < m_config.nestedAttributeCount; ++i)
+        {
+            data.setValue("nested" + to_string(i), nestedData(1));
+        }
+        for (size_t i = 0; i < m_config.orderedListCount; ++i)
+        {
+            vector<string> values;
+            for (size_t j = 0; j < m_config.listLength; ++j)
+            {
+                values.push_back(randomValue());
+            }
+            data.setValue("list" + to_string(i), values);
+        }
+        amlObj.addData(name, std::move(data));
+    }
+
+    return amlObj;
+}
+
+void AMLGenerator::events(size_t count, vector<AMLObject>& amlObjs)
+{
+    amlObjs.reserve(amlObjs.size() + count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        amlObjs.push_back(event());
+    }
+}
+
+AMLData AMLGenerator::nestedData(size_t level)
+{
+    AMLData data;
+    data.setValue("v", randomValue());
+    if (level < m_config.nestingDepth)
+    {
+        data.setValue("n", nestedData(level + 1));
+    }
+    return data;
+}
+
+// signal-like values, which are integers or decimals of various lengths
+string AMLGenerator::randomValue()
+{
+    uniform_int_distribution<int> value(-100000, 1000000);
+    int v = value(m_random);
+    if (0 == (m_random() & 1))
+    {
+        return to_string(v);
+    }
+    string decimal = to_string(v / 100) + "." + to_string(100 + std::abs(v % 100)).substr(1);
+    return (v < 0 && v > -100) ? "-" + decimal : decimal;
+}
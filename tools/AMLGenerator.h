@@ -0,0 +1,126 @@
+/*******************************************************************************
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *******************************************************************************/
+
+#ifndef AML_GENERATOR_H_
+#define AML_GENERATOR_H_
+
+#include <cstddef>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "AMLInterface.h"
+
+namespace AML
+{
+
+/**
+ * @struct AMLGeneratorConfig
+ * @brief Shape of the model which is generated by AMLGenerator.
+ *        The default is a 400-signal model of 4 SystemUnitClasses with 100 string attributes each.
+ */
+struct AMLGeneratorConfig
+{
+    size_t          systemUnitClassCount = 4;       // SystemUnitClasses "Unit<i>", besides "Event"
+    size_t          attributeCount = 100;           // string attributes "s<i>" of each SystemUnitClass
+    size_t          nestedAttributeCount = 0;       // nested attributes "nested<i>" of each SystemUnitClass
+    size_t          nestingDepth = 2;               // levels of each nested attribute, which has "v" and the next level "n"
+    size_t          orderedListCount = 0;           // OrderedListType attributes "list<i>" of each SystemUnitClass
+    size_t          listLength = 8;                 // number of values of each OrderedListType attribute in events
+    size_t          roleClassAttributeCount = 1;    // attributes "c<i>" of each RoleClass
+    size_t          extraRoleClassCount = 0;        // RoleClasses "Role<i>" which have no SystemUnitClass
+    std::string     deviceId = "GEN001";            // device of events, which is the name of RoleClassLib
+    unsigned        seed = 1;                       // seed of the values of events
+};
+
+/**
+ * @class AMLGenerator
+ * @brief This class generates a valid CAEX model of the configured shape and random AMLObjects which match it,
+ *        for benchmarks and tests of models which are larger than the samples.
+ *        Every RoleClass attribute has a value and every SystemUnitClass has a RoleClass of the same name,
+ *        so that Representation::getConfigInfo() works with the model.
+ *        Events are deterministic for the seed.
+ */
+class AMLGenerator
+{
+public:
+    /**
+     * @brief       Constructor.
+     * @param       config  [in] Shape of the model.
+     * @exception   AMLException If nestingDepth is 0 while there are nested attributes, or listLength is 0 while there are OrderedListType attributes.
+     */
+    explicit AMLGenerator(const AMLGeneratorConfig& config = AMLGeneratorConfig());
+
+    /**
+     * @fn const AMLGeneratorConfig& config() const
+     * @brief       This function returns the shape of the model.
+     * @return      Configuration which is given to the constructor.
+     */
+    const AMLGeneratorConfig&       config() const;
+
+    /**
+     * @fn std::string model() const
+     * @brief       This function returns the CAEX model as a string.
+     * @return      AML string of the model.
+     */
+    std::string                     model() const;
+
+    /**
+     * @fn void writeModel(const std::string& filePath) const
+     * @brief       This function writes the CAEX model to a file, which can be given to the constructor of Representation.
+     * @param       filePath    [in] Path of the file.
+     * @exception   AMLException If the file can not be written.
+     */
+    void                            writeModel(const std::string& filePath) const;
+
+    /**
+     * @fn std::vector<std::string> dataNames() const
+     * @brief       This function returns the names of SystemUnitClasses, which are the names of AMLData in events.
+     * @return      Names of SystemUnitClasses except "Event".
+     */
+    std::vector<std::string>        dataNames() const;
+
+    /**
+     * @fn AMLObject event()
+     * @brief       This function returns the next event, which has an AMLData of every SystemUnitClass with random values.
+     *              Timestamps of events are increased one by one.
+     * @return      AMLObject matching the model.
+     */
+    AMLObject                       event();
+
+    /**
+     * @fn void events(size_t count, std::vector<AMLObject>& amlObjs)
+     * @brief       This function appends the next events to amlObjs.
+     * @param       count       [in] Number of events.
+     * @param       amlObjs     [out] Vector which the events are appended to.
+     */
+    void                            events(size_t count, std::vector<AMLObject>& amlObjs);
+
+private:
+    AMLData                         nestedData(size_t level);
+    std::string                     randomValue();
+
+    AMLGeneratorConfig              m_config;
+    std::vector<std::string>        m_dataNames;
+    std::vector<std::string>        m_attributeNames;
+    std::mt19937                    m_random;
+    unsigned long long              m_timeStamp;
+};
+
+} // namespace AML
+
+#endif // AML_GENERATOR_H_
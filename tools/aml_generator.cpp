@@ -0,0 +1,142 @@
+/*******************************************************************************
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *******************************************************************************/
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "AMLGenerator.h"
+#include "Representation.h"
+#include "AMLInterface.h"
+#include "AMLException.h"
+
+using namespace std;
+using namespace AML;
+
+/*
+    Writes a generated model to <prefix>.aml and events of it to <prefix>_<index>.aml,
+    and to <prefix>_<index>.bin as well unless protobuf is disabled.
+    Events are converted with Representation of the model written, so the output is checked to be valid.
+*/
+
+static void usage()
+{
+    AMLGeneratorConfig config;
+    cout << "Usage: aml_generator [options] <output prefix>" << endl
+         << "  --classes=N          SystemUnitClasses (default " << config.systemUnitClassCount << ")" << endl
+         << "  --attributes=N       string attributes of each SystemUnitClass (default " << config.attributeCount << ")" << endl
+         << "  --nested=N           nested attributes of each SystemUnitClass (default " << config.nestedAttributeCount << ")" << endl
+         << "  --depth=N            levels of each nested attribute (default " << config.nestingDepth << ")" << endl
+         << "  --lists=N            OrderedListType attributes of each SystemUnitClass (default " << config.orderedListCount << ")" << endl
+         << "  --list-length=N      values of each OrderedListType attribute (default " << config.listLength << ")" << endl
+         << "  --role-attributes=N  attributes of each RoleClass (default " << config.roleClassAttributeCount << ")" << endl
+         << "  --extra-roles=N      RoleClasses without SystemUnitClass (default " << config.extraRoleClassCount << ")" << endl
+         << "  --events=N           events written (default 10)" << endl
+         << "  --seed=N             seed of the values of events (default " << config.seed << ")" << endl;
+}
+
+// returns true and sets value if arg is "<name>=<value>"
+static bool parseOption(const char* arg, const char* name, size_t& value)
+{
+    size_t length = strlen(name);
+    if (0 != strncmp(arg, name, length) || '=' != arg[length])
+    {
+        return false;
+    }
+    value = strtoul(arg + length + 1, nullptr, 10);
+    return true;
+}
+
+static void writeFile(const string& filePath, const string& data)
+{
+    ofstream file(filePath, ios::binary);
+    file << data;
+    file.close();
+    if (!file)
+    {
+        throw AMLException(INVALID_FILE_PATH);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    AMLGeneratorConfig config;
+    size_t eventCount = 10;
+    size_t seed = config.seed;
+    string prefix;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const char* arg = argv[i];
+        if (parseOption(arg, "--classes", config.systemUnitClassCount) ||
+            parseOption(arg, "--attributes", config.attributeCount) ||
+            parseOption(arg, "--nested", config.nestedAttributeCount) ||
+            parseOption(arg, "--depth", config.nestingDepth) ||
+            parseOption(arg, "--lists", config.orderedListCount) ||
+            parseOption(arg, "--list-length", config.listLength) ||
+            parseOption(arg, "--role-attributes", config.roleClassAttributeCount) ||
+            parseOption(arg, "--extra-roles", config.extraRoleClassCount) ||
+            parseOption(arg, "--events", eventCount) ||
+            parseOption(arg, "--seed", seed))
+        {
+            continue;
+        }
+        if ('-' == arg[0] || !prefix.empty())
+        {
+            usage();
+            return 1;
+        }
+        prefix = arg;
+    }
+
+    if (prefix.empty())
+    {
+        usage();
+        return 1;
+    }
+    config.seed = static_cast<unsigned>(seed);
+
+    try
+    {
+        AMLGenerator generator(config);
+
+        string modelFile = prefix + ".aml";
+        generator.writeModel(modelFile);
+
+        Representation rep(modelFile);
+
+        for (size_t i = 0; i < eventCount; ++i)
+        {
+            AMLObject amlObj = generator.event();
+            writeFile(prefix + "_" + to_string(i) + ".aml", rep.DataToAml(amlObj));
+#ifndef _DISABLE_PROTOBUF_
+            writeFile(prefix + "_" + to_string(i) + ".bin", rep.DataToByte(amlObj));
+#endif
+        }
+
+        cout << "model : " << modelFile << ", events : " << eventCount << endl;
+    }
+    catch (const AMLException& e)
+    {
+        cout << "Exception : " << e.what() << endl;
+        return 1;
+    }
+
+    return 0;
+}
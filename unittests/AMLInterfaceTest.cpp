@@ -19,6 +19,8 @@
 #include <string>
 #include <fstream>
 #include <algorithm>
+#include <thread>
+#include <type_traits>
 
 #include "AMLInterface.h"
 #include "AMLException.h"
@@ -170,6 +172,109 @@ namespace AMLInterfaceTest
         }
     }
 
+    TEST(AMLData_setValueMoveTest, Valid)
+    {
+        AMLData amlData;
+
+        string value1 = "value1";
+        vector<string> value2 = {"value2"};
+        AMLData value3;
+        EXPECT_NO_THROW(value3.setValue("key", string("value")));
+
+        EXPECT_NO_THROW(amlData.setValue("key1", std::move(value1)));
+        EXPECT_NO_THROW(amlData.setValue("key2", std::move(value2)));
+        EXPECT_NO_THROW(amlData.setValue("key3", std::move(value3)));
+
+        EXPECT_TRUE("value1" == amlData.getValueToStr("key1"));
+        EXPECT_TRUE(vector<string>{"value2"} == amlData.getValueToStrArr("key2"));
+        EXPECT_TRUE("value" == amlData.getValueToAMLData("key3").getValueToStr("key"));
+    }
+
+    TEST(AMLData_emplaceDataTest, Valid)
+    {
+        AMLData amlData;
+
+        AMLData& value = amlData.emplaceData("key");
+        EXPECT_NO_THROW(value.setValue("subKey", "subValue"));
+
+        EXPECT_TRUE("subValue" == amlData.getValueToAMLData("key").getValueToStr("subKey"));
+        try
+        {
+            amlData.emplaceData("key");
+            FAIL();
+        }
+        catch (const AMLException& e)
+        {
+            EXPECT_EQ(e.code(), KEY_ALREADY_EXIST);
+        }
+    }
+
+    TEST(AMLData_clearTest, Valid)
+    {
+        AMLData amlData;
+        EXPECT_NO_THROW(amlData.setValue("key1", "value1"));
+        EXPECT_NO_THROW(amlData.emplaceData("key2").setValue("subKey", "subValue"));
+
+        AMLData copyData(amlData);
+        amlData.clear();
+        EXPECT_TRUE(amlData.getKeys().empty());
+
+        // keys can be set again with values of other types, and the copy is not affected
+        EXPECT_NO_THROW(amlData.setValue("key2", "value2"));
+        EXPECT_NO_THROW(amlData.emplaceData("key1"));
+        EXPECT_TRUE("value2" == amlData.getValueToStr("key2"));
+        EXPECT_TRUE(amlData.getValueToAMLData("key1").getKeys().empty());
+
+        EXPECT_TRUE("value1" == copyData.getValueToStr("key1"));
+        EXPECT_TRUE("subValue" == copyData.getValueToAMLData("key2").getValueToStr("subKey"));
+    }
+
+    TEST(AMLData_moveAssignmentTest, Merge)
+    {
+        AMLData amlData;
+        AMLData other;
+        EXPECT_NO_THROW(amlData.setValue("key1", "value1"));
+        EXPECT_NO_THROW(other.setValue("key2", "value2"));
+
+        EXPECT_NO_THROW(amlData = std::move(other));
+        EXPECT_TRUE("value1" == amlData.getValueToStr("key1"));
+        EXPECT_TRUE("value2" == amlData.getValueToStr("key2"));
+
+        AMLData duplicated;
+        EXPECT_NO_THROW(duplicated.setValue("key1", "value"));
+        try
+        {
+            amlData = std::move(duplicated);
+            FAIL();
+        }
+        catch (const AMLException& e)
+        {
+            EXPECT_EQ(e.code(), KEY_ALREADY_EXIST);
+        }
+    }
+
+    TEST(AMLData_copyTest, ModifyCopy)
+    {
+        AMLData value;
+        EXPECT_NO_THROW(value.setValue("subKey", "subValue"));
+
+        AMLData origin;
+        EXPECT_NO_THROW(origin.setValue("key1", "value1"));
+        EXPECT_NO_THROW(origin.setValue("key2", value));
+
+        AMLData copy(origin);
+        EXPECT_NO_THROW(copy.setValue("key3", "value3"));
+        EXPECT_NO_THROW(copy.emplaceData("key4").setValue("subKey", "subValue"));
+
+        EXPECT_EQ(2u, origin.getKeys().size());
+        EXPECT_EQ(4u, copy.getKeys().size());
+        EXPECT_TRUE("subValue" == copy.getValueToAMLData("key2").getValueToStr("subKey"));
+
+        EXPECT_NO_THROW(origin.setValue("key5", "value5"));
+        EXPECT_EQ(3u, origin.getKeys().size());
+        EXPECT_EQ(4u, copy.getKeys().size());
+    }
+
     TEST(AMLData_getValueStrTest, Valid)
     {
         AMLData amlData;
@@ -484,4 +589,121 @@ namespace AMLInterfaceTest
 
         EXPECT_TRUE(value == cloneData.getValueToStr(key));
     }
+
+    TEST(AMLObjectTest, MoveConstructor)
+    {
+        AMLObject originObj("deviceId", "timeStamp");
+
+        AMLData amlData;
+        EXPECT_NO_THROW(amlData.setValue("key", "value"));
+        EXPECT_NO_THROW(originObj.addData("dataName", std::move(amlData)));
+
+        AMLObject movedObj(std::move(originObj));
+
+        EXPECT_TRUE("deviceId" == movedObj.getDeviceId());
+        EXPECT_TRUE("value" == movedObj.getData("dataName").getValueToStr("key"));
+    }
+
+    TEST(AMLObjectTest, NothrowMoveConstructor)
+    {
+        // so that AMLObjects are moved rather than copied when a vector of them grows
+        EXPECT_TRUE(std::is_nothrow_move_constructible<AMLObject>::value);
+        EXPECT_TRUE(std::is_nothrow_move_constructible<AMLData>::value);
+    }
+
+    TEST(AMLObjectTest, emplaceData)
+    {
+        AMLObject amlObj("deviceId", "timeStamp");
+
+        AMLData& amlData = amlObj.emplaceData("dataName1");
+        EXPECT_NO_THROW(amlObj.emplaceData("dataName2"));
+        EXPECT_NO_THROW(amlData.setValue("key", "value"));
+
+        EXPECT_TRUE("value" == amlObj.getData("dataName1").getValueToStr("key"));
+        try
+        {
+            amlObj.emplaceData("dataName1");
+            FAIL();
+        }
+        catch (const AMLException& e)
+        {
+            EXPECT_EQ(e.code(), KEY_ALREADY_EXIST);
+        }
+    }
+
+    TEST(AMLObjectTest, reset)
+    {
+        AMLObject amlObj("deviceId", "timeStamp");
+        EXPECT_NO_THROW(amlObj.emplaceData("dataName").setValue("key", "value"));
+        AMLObject copyObj(amlObj);
+
+        EXPECT_NO_THROW(amlObj.reset("deviceId2", "timeStamp2", "id2"));
+        EXPECT_TRUE("deviceId2" == amlObj.getDeviceId());
+        EXPECT_TRUE("timeStamp2" == amlObj.getTimeStamp());
+        EXPECT_TRUE("id2" == amlObj.getId());
+        EXPECT_TRUE(amlObj.getDataNames().empty());
+
+        EXPECT_NO_THROW(amlObj.emplaceData("dataName").setValue("key", vector<string>{"value2"}));
+        EXPECT_TRUE(vector<string>{"value2"} == amlObj.getData("dataName").getValueToStrArr("key"));
+        EXPECT_TRUE("value" == copyObj.getData("dataName").getValueToStr("key"));
+
+        try
+        {
+            amlObj.reset("", "timeStamp", "id");
+            FAIL();
+        }
+        catch (const AMLException& e)
+        {
+            EXPECT_EQ(e.code(), INVALID_PARAM);
+        }
+    }
+
+    TEST(AMLObjectTest, ModifyCopy)
+    {
+        AMLObject originObj("deviceId", "timeStamp");
+        EXPECT_NO_THROW(originObj.emplaceData("dataName1").setValue("key", "value"));
+
+        AMLObject cloneObj(originObj);
+        EXPECT_NO_THROW(cloneObj.emplaceData("dataName2").setValue("key", "value"));
+
+        EXPECT_EQ(1u, originObj.getDataNames().size());
+        EXPECT_EQ(2u, cloneObj.getDataNames().size());
+        EXPECT_TRUE("value" == cloneObj.getData("dataName1").getValueToStr("key"));
+    }
+
+    TEST(AMLObjectTest, ReadCopiesConcurrently)
+    {
+        AMLObject originObj("deviceId", "timeStamp");
+        AMLData& amlData = originObj.emplaceData("dataName");
+        EXPECT_NO_THROW(amlData.setValue("key", "value"));
+        EXPECT_NO_THROW(amlData.emplaceData("map").setValue("key", "value"));
+
+        vector<int> results(4, 0);
+        vector<thread> threads;
+        for (size_t i = 0; i < results.size(); i++)
+        {
+            threads.push_back(thread([&originObj, &results, i]()
+            {
+                bool result = true;
+                for (int n = 0; n < 1000; n++)
+                {
+                    AMLObject cloneObj(originObj);
+                    AMLData cloneData = cloneObj.getData("dataName");
+                    cloneData.setValue("thread", "value");
+                    cloneObj.addData("thread", cloneData);
+
+                    result = result && "value" == cloneObj.getData("dataName").getValueToAMLData("map").getValueToStr("key")
+                                    && 2u == cloneObj.getDataNames().size() && 1u == originObj.getDataNames().size();
+                }
+                results[i] = result ? 1 : 0;
+            }));
+        }
+        for (auto& t : threads)
+        {
+            t.join();
+        }
+
+        EXPECT_TRUE(std::count(results.begin(), results.end(), 1) == (int)results.size());
+        EXPECT_EQ(2u, originObj.getData("dataName").getKeys().size());
+    }
 }
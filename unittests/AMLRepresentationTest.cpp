@@ -15,13 +15,21 @@
  *
  *******************************************************************************/
 
+#include <string.h>
 #include <iostream>
 #include <string>
 #include <fstream>
+#include <vector>
+#include <atomic>
+#include <stdexcept>
+#include <dirent.h>
+#include <sys/stat.h>
 
 #include "Representation.h"
 #include "AMLInterface.h"
 #include "AMLException.h"
+#include "AMLGenerator.h"
+#include "internal/AMLCache.h"
 #include "gtest/gtest.h"
 
 using namespace std;
@@ -34,6 +42,8 @@ namespace AMLRepresentationTest
     std::string amlModelFile_invalid_NoSUCL = "./TEST_DataModel_Invalid_NoSUCL.aml";
     std::string amlDataFile                 = "./TEST_Data.aml";
     std::string dataBinaryFile              = "./TEST_DataBinary";
+    std::string generatedModelFile          = "./TEST_GeneratedModel.aml"; // written by AMLGenerator
+    std::string modelCacheDir               = "./TEST_ModelCache";
 
     std::string amlModelId                  = "SAMPLE_Robot_0.0.1"; // from "TEST_DataModel.aml" file
 
@@ -79,6 +89,34 @@ namespace AMLRepresentationTest
         return amlObj;
     }
 
+    // AMLObject of the same model as TestAMLObject() with other values
+    AMLObject OtherAMLObject()
+    {
+        AMLObject amlObj("SAMPLE002", "987654321", "SAMPLE002_987654321_0");
+
+        AMLData model;
+        model.setValue("a", "Model_0");
+        model.setValue("b", "SR-P7-971");
+
+        AMLData axis;
+        axis.setValue("x", "0");
+        axis.setValue("y", "1");
+        axis.setValue("z", "2");
+
+        AMLData info;
+        info.setValue("id", "0");
+        info.setValue("axis", axis);
+
+        AMLData sample;
+        sample.setValue("info", info);
+        sample.setValue("appendix", vector<string>{"1", "2", "3", "4", "5"});
+
+        amlObj.addData("Model", model);
+        amlObj.addData("Sample", sample);
+
+        return amlObj;
+    }
+
     std::string TestAML()
     {
         std::ifstream t(amlDataFile);
@@ -86,6 +124,13 @@ namespace AMLRepresentationTest
         return str;
     }
 
+    std::string TestModel(const std::string& modelFile)
+    {
+        std::ifstream t(modelFile);
+        std::string str((std::istreambuf_iterator<char>(t)), std::istreambuf_iterator<char>());
+        return str;
+    }
+
     std::string TestBinary()
     {
         std::ifstream t(dataBinaryFile);
@@ -205,6 +250,288 @@ namespace AMLRepresentationTest
         }
     }
 
+    // 400 signals of the default AMLGeneratorConfig, with nested attributes and OrderedListTypes
+    AMLGeneratorConfig GeneratedModelConfig()
+    {
+        AMLGeneratorConfig config;
+        config.nestedAttributeCount = 2;
+        config.nestingDepth = 4;
+        config.orderedListCount = 2;
+        config.listLength = 16;
+        config.extraRoleClassCount = 2;
+        return config;
+    }
+
+    // Helper method : compiled-model cache files in modelCacheDir, which is created if it does not exist
+    vector<string> ModelCacheFiles()
+    {
+        mkdir(modelCacheDir.c_str(), 0755);
+
+        vector<string> files;
+        DIR* dir = opendir(modelCacheDir.c_str());
+        for (struct dirent* entry = readdir(dir); NULL != entry; entry = readdir(dir))
+        {
+            string name(entry->d_name);
+            if (name.size() > 5 && 0 == name.compare(name.size() - 5, 5, ".amlc"))
+            {
+                files.push_back(modelCacheDir + "/" + name);
+            }
+        }
+        closedir(dir);
+        return files;
+    }
+
+    void RemoveModelCacheFiles()
+    {
+        for (const string& file : ModelCacheFiles())
+        {
+            remove(file.c_str());
+        }
+    }
+
+    // Helper method : reads a template written by AMLTemplate::save(), and returns the position of the type of its first slot
+    const char* ReadCachedTemplate(AMLCacheReader& reader)
+    {
+        std::string text, key, itemText;
+        uint64_t count = 0, value;
+        const char* firstType = NULL;
+        EXPECT_TRUE(reader.readString(text) && reader.readU64(count));
+
+        for (uint64_t i = 0; i < count; i++)
+        {
+            const char* type;
+            EXPECT_TRUE(reader.readBytes(1, type) && reader.readString(key) && reader.readU64(value) && reader.readU64(value) &&
+                        reader.readString(itemText) && reader.readU64(value) && reader.readU64(value) && reader.readU64(value));
+            firstType = (0 == i) ? type : firstType;
+        }
+        return firstType;
+    }
+
+    TEST(ConstructRepresentationTest, CompileIntoCache)
+    {
+        RemoveModelCacheFiles();
+        Representation compiled = Representation(amlModelFile, modelCacheDir);
+        ASSERT_EQ((size_t)1, ModelCacheFiles().size());
+
+        // loaded from the cache
+        Representation rep = Representation(amlModelFile, modelCacheDir);
+        AMLObject amlObj = TestAMLObject();
+
+        EXPECT_EQ(amlModelId, rep.getRepresentationId());
+        EXPECT_EQ(TestAML(), rep.DataToAml(amlObj));
+
+        AMLObject* decoded = rep.AmlToData(TestAML());
+        EXPECT_TRUE(isEqual(*decoded, amlObj));
+        delete decoded;
+
+        AMLObject* config = rep.getConfigInfo();
+        AMLObject* varify = Representation(amlModelFile).getConfigInfo();
+        EXPECT_TRUE(isEqual(*config, *varify));
+        delete config;
+        delete varify;
+
+#ifndef _DISABLE_PROTOBUF_
+        EXPECT_EQ(TestBinary(), rep.DataToByte(amlObj));
+#endif
+    }
+
+    TEST(ConstructRepresentationTest, RecompileInvalidCache)
+    {
+        RemoveModelCacheFiles();
+        Representation compiled = Representation(amlModelFile, modelCacheDir);
+        vector<string> files = ModelCacheFiles();
+        ASSERT_EQ((size_t)1, files.size());
+
+        // truncated cache
+        std::string cache;
+        {
+            std::ifstream in(files[0], std::ios::binary);
+            cache.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        }
+        {
+            std::ofstream out(files[0], std::ios::binary);
+            out << cache.substr(0, cache.size() / 2);
+        }
+
+        Representation rep = Representation(amlModelFile, modelCacheDir);
+        EXPECT_EQ(TestAML(), rep.DataToAml(TestAMLObject()));
+
+        // the cache is written again
+        {
+            std::ifstream in(files[0], std::ios::binary);
+            EXPECT_EQ(cache, std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()));
+        }
+
+        // cache of another model is not used
+        AMLGenerator generator(GeneratedModelConfig());
+        generator.writeModel(generatedModelFile);
+        Representation generated = Representation(generatedModelFile, modelCacheDir);
+        EXPECT_EQ((size_t)2, ModelCacheFiles().size());
+        EXPECT_EQ(rep.getRepresentationId(), Representation(amlModelFile, modelCacheDir).getRepresentationId());
+        EXPECT_EQ(Representation(generatedModelFile).getRepresentationId(), generated.getRepresentationId());
+    }
+
+    TEST(ConstructRepresentationTest, RecompileCacheOfInvalidSlot)
+    {
+        RemoveModelCacheFiles();
+        Representation compiled = Representation(amlModelFile, modelCacheDir);
+        vector<string> files = ModelCacheFiles();
+        ASSERT_EQ((size_t)1, files.size());
+        std::string cache = TestModel(files[0]);
+
+        // header : magic, version, source hash, payload hash and payload size
+        const size_t payloadHashOffset = 20;
+        const size_t payloadOffset = 36;
+        AMLCacheReader reader(cache.data() + payloadOffset, cache.data() + cache.size());
+
+        const char* source;
+        size_t sourceSize;
+        std::string value;
+        uint8_t hasEventTemplate;
+        uint64_t count;
+        ASSERT_TRUE(reader.readString(source, sourceSize) && reader.readString(value) && reader.readU8(hasEventTemplate) && reader.readU64(count));
+        for (uint64_t i = 0; i < count; i++)
+        {
+            ASSERT_TRUE(reader.readString(value));
+        }
+
+        // the first slots of a SystemUnitClass and of the event
+        vector<const char*> slotTypes;
+        ASSERT_TRUE(reader.readU64(count));
+        for (uint64_t i = 0; i < count; i++)
+        {
+            ASSERT_TRUE(reader.readString(value));
+            const char* slotType = ReadCachedTemplate(reader);
+            if (0 == i)
+            {
+                slotTypes.push_back(slotType);
+            }
+        }
+        slotTypes.push_back(ReadCachedTemplate(reader));
+        ASSERT_TRUE(NULL != slotTypes[0] && NULL != slotTypes[1]);
+
+        // value of AMLObject(DeviceId) in a SystemUnitClass, and value of AMLData(String) out of AMLData in the event
+        const char invalidTypes[] = {4, 0};
+        for (size_t i = 0; i < 2; i++)
+        {
+            ASSERT_NE(invalidTypes[i], *slotTypes[i]);
+
+            std::string tampered(cache);
+            tampered[slotTypes[i] - cache.data()] = invalidTypes[i];
+
+            // the payload hash is not a signature, so it matches the tampered payload
+            std::string hash;
+            AMLCacheWriter writer(hash);
+            writer.writeU64(hashContent(tampered.data() + payloadOffset, tampered.size() - payloadOffset));
+            tampered.replace(payloadHashOffset, hash.size(), hash);
+            {
+                std::ofstream out(files[0], std::ios::binary);
+                out << tampered;
+            }
+
+            Representation rep = Representation(amlModelFile, modelCacheDir);
+            EXPECT_EQ(TestAML(), rep.DataToAml(TestAMLObject()));
+
+            // the cache is written again
+            EXPECT_EQ(cache, TestModel(files[0]));
+        }
+    }
+
+    TEST(ConstructRepresentationTest, InvalidFilePathWithCache)
+    {
+        try
+        {
+            Representation rep = Representation("NoExist.aml", modelCacheDir);
+            FAIL();
+        }
+        catch (const AMLException& e)
+        {
+            EXPECT_EQ(e.code(), INVALID_FILE_PATH);
+        }
+    }
+
+    TEST(ConstructRepresentationTest, ValidBuffer)
+    {
+        std::string model = TestModel(amlModelFile);
+        Representation rep = Representation(model.data(), model.size());
+        model.clear();
+
+        AMLObject amlObj = TestAMLObject();
+        EXPECT_EQ(amlModelId, rep.getRepresentationId());
+        EXPECT_EQ(TestAML(), rep.DataToAml(amlObj));
+
+        AMLObject* config = rep.getConfigInfo();
+        AMLObject* varify = Representation(amlModelFile).getConfigInfo();
+        EXPECT_TRUE(isEqual(*config, *varify));
+        delete config;
+        delete varify;
+
+#ifndef _DISABLE_PROTOBUF_
+        EXPECT_EQ(TestBinary(), rep.DataToByte(amlObj));
+#endif
+    }
+
+    TEST(ConstructRepresentationTest, ValidBufferInPlace)
+    {
+        // buffer parsed in place is kept until Representation is destroyed
+        std::string model = TestModel(amlModelFile);
+        std::vector<char> buffer(model.begin(), model.end());
+        Representation rep = Representation(buffer.data(), buffer.size(), true);
+
+        AMLObject amlObj = TestAMLObject();
+        EXPECT_EQ(amlModelId, rep.getRepresentationId());
+        EXPECT_EQ(TestAML(), rep.DataToAml(amlObj));
+
+        AMLObject* decoded = rep.AmlToData(TestAML());
+        EXPECT_TRUE(isEqual(*decoded, amlObj));
+        delete decoded;
+
+#ifndef _DISABLE_PROTOBUF_
+        EXPECT_EQ(TestBinary(), rep.DataToByte(amlObj));
+#endif
+
+        // copied unless it is parsed in place
+        std::vector<char> copied(model.begin(), model.end());
+        Representation copiedRep = Representation(copied.data(), copied.size(), false);
+        EXPECT_EQ(model, std::string(copied.begin(), copied.end()));
+        EXPECT_EQ(TestAML(), copiedRep.DataToAml(amlObj));
+    }
+
+    TEST(ConstructRepresentationTest, InvalidBuffer)
+    {
+        try
+        {
+            Representation rep = Representation(NULL, 0);
+            FAIL();
+        }
+        catch (const AMLException& e)
+        {
+            EXPECT_EQ(e.code(), INVALID_PARAM);
+        }
+
+        std::string model = TestModel(amlModelFile);
+        try
+        {
+            Representation rep = Representation(model.data(), model.size() / 2);
+            FAIL();
+        }
+        catch (const AMLException& e)
+        {
+            EXPECT_EQ(e.code(), INVALID_XML_STR);
+        }
+
+        model = TestModel(amlModelFile_invalid_NoCAEX);
+        try
+        {
+            Representation rep = Representation(&model[0], model.size(), true);
+            FAIL();
+        }
+        catch (const AMLException& e)
+        {
+            EXPECT_EQ(e.code(), INVALID_AML_SCHEMA);
+        }
+    }
+
     TEST(AmlToDataTest, ConvertValid)
     {
         Representation rep = Representation(amlModelFile);
@@ -237,139 +564,954 @@ namespace AMLRepresentationTest
         if (NULL != amlObj)  delete amlObj;
     }
 
-    TEST(DataToAmlTest, ConvertValid)
+    TEST(AmlToDataTest, ConvertValidBuffer)
     {
         Representation rep = Representation(amlModelFile);
-        AMLObject amlObj = TestAMLObject();
-        std::string amlStr;
-        EXPECT_NO_THROW(amlStr = rep.DataToAml(amlObj));
+        AMLObject* amlObj = NULL;
+        std::string amlStr = TestAML();
+        std::vector<char> buffer(amlStr.begin(), amlStr.end());
 
-        std::string varify = TestAML();
-        EXPECT_EQ(varify.compare(amlStr), 0); //@TODO: issue - it does not return 0 though they are same string 
+        EXPECT_NO_THROW(amlObj = rep.AmlToData(buffer.data(), buffer.size()));
+
+        AMLObject varify = TestAMLObject();
+        EXPECT_TRUE(isEqual(*amlObj, varify));
+
+        if (NULL != amlObj) delete amlObj;
     }
 
-    TEST(DataToAmlTest, InvalidDataToModel)
+    TEST(AmlToDataTest, InvalidAmlBuffer)
     {
         Representation rep = Representation(amlModelFile);
-
-        AMLObject notMatchToModel("deviceId", "0");
-
-        AMLData data;
-        data.setValue("invalidKey", "invalidValue");
-
-        notMatchToModel.addData("invalidData", data);
+        AMLObject* amlObj = NULL;
+        char invalidAml[] = "<invalid />";
 
         try
         {
-            rep.DataToAml(notMatchToModel);
+            amlObj = rep.AmlToData(invalidAml, strlen(invalidAml));
             FAIL();
         }
         catch (const AMLException& e)
         {
-            EXPECT_EQ(e.code(), NOT_MATCH_TO_AML_MODEL);
+            EXPECT_EQ(e.code(), INVALID_AML_SCHEMA);
         }
+
+        if (NULL != amlObj)  delete amlObj;
     }
 
-    TEST(DataToAmlTest, IgnoreDataNotInModel)
+    TEST(AmlToDataTest, ConvertWithXmlMarkups)
     {
         Representation rep = Representation(amlModelFile);
-        AMLObject amlObj = TestAMLObject();
+        AMLObject* amlObj = NULL;
+        std::string amlStr = TestAML();
 
-        AMLData sample = amlObj.getData("Sample");
-        sample.setValue("additionalKey", "additionalValue");
+        amlStr.insert(amlStr.find("<CAEXFile"), "<!-- comment -->\n<?pi instruction?>\n");
+        amlStr.replace(amlStr.find("<Value>20</Value>"), strlen("<Value>20</Value>"), "<Value><![CDATA[20]]></Value>");
+        amlStr.replace(amlStr.find("<Value>110</Value>"), strlen("<Value>110</Value>"), "<Value>&#49;1&#x30;<!-- comment --></Value>");
 
-        std::string amlStr;
-        EXPECT_NO_THROW(amlStr = rep.DataToAml(amlObj));
+        EXPECT_NO_THROW(amlObj = rep.AmlToData(amlStr));
 
-        AMLObject *resultObj = NULL;
-        EXPECT_NO_THROW(resultObj = rep.AmlToData(amlStr));
+        AMLObject varify = TestAMLObject();
+        EXPECT_TRUE(isEqual(*amlObj, varify));
 
-        AMLData sampleResult = resultObj->getData("Sample");
+        if (NULL != amlObj) delete amlObj;
+    }
+
+    TEST(AmlToDataTest, MalformedModel)
+    {
+        Representation rep = Representation(amlModelFile);
+        AMLObject* amlObj = NULL;
+        std::string amlStr = TestAML();
+
+        // InstanceHierarchy is valid, but the end of SystemUnitClassLib is missing
+        amlStr.erase(amlStr.rfind("</SystemUnitClassLib>"));
 
         try
         {
-            sampleResult.getValueToStr("additionalKey");
+            amlObj = rep.AmlToData(amlStr);
             FAIL();
         }
         catch (const AMLException& e)
         {
-            EXPECT_EQ(e.code(), KEY_NOT_EXIST);
+            EXPECT_EQ(e.code(), INVALID_XML_STR);
         }
 
-        if (NULL != resultObj) delete resultObj;
+        if (NULL != amlObj)  delete amlObj;
     }
 
-    TEST(ByteToDataTest, ConvertValid)
+    TEST(AmlToDataTest, InvalidOrderedList)
     {
         Representation rep = Representation(amlModelFile);
         AMLObject* amlObj = NULL;
-        std::string binary = TestBinary();
-
-#ifndef _DISABLE_PROTOBUF_
-        EXPECT_NO_THROW(amlObj = rep.ByteToData(binary));
+        std::string amlStr = TestAML();
 
-        AMLObject varify = TestAMLObject();
-        EXPECT_TRUE(isEqual(*amlObj, varify));
+        // items of ordered list should be named "1", "2", "3"
+        amlStr.replace(amlStr.find("<Attribute Name=\"3\""), strlen("<Attribute Name=\"3\""), "<Attribute Name=\"2\"");
 
-        if (NULL != amlObj)  delete amlObj;
-#else
         try
         {
-            amlObj = rep.ByteToData(binary);
+            amlObj = rep.AmlToData(amlStr);
             FAIL();
-            (void)amlObj;
         }
         catch (const AMLException& e)
         {
-            EXPECT_EQ(e.code(), API_NOT_ENABLED);
+            EXPECT_EQ(e.code(), INVALID_AML_SCHEMA);
         }
-#endif
+
+        if (NULL != amlObj)  delete amlObj;
     }
 
-    TEST(ByteToDataTest, InvalidByte)
+    TEST(AmlToDataTest, ModifyDataAfterDestroyingRepresentation)
     {
-        Representation rep = Representation(amlModelFile);
         AMLObject* amlObj = NULL;
-        std::string amlBinary("invalidBinary");
+        {
+            Representation rep = Representation(amlModelFile);
+            EXPECT_NO_THROW(amlObj = rep.AmlToData(TestAML()));
+        }
+        ASSERT_TRUE(NULL != amlObj);
 
+        // keys defined by the model and other keys are kept in the same order
+        AMLData info = amlObj->getData("Sample").getValueToAMLData("info");
+        EXPECT_NO_THROW(info.setValue("x", "1"));
+        EXPECT_NO_THROW(info.setValue("b0", "2"));
+        EXPECT_NO_THROW(info.setValue("zz", "3"));
         try
         {
-            amlObj = rep.ByteToData(amlBinary);
+            info.setValue("id", "4");
             FAIL();
         }
         catch (const AMLException& e)
         {
-#ifndef _DISABLE_PROTOBUF_
-            EXPECT_EQ(e.code(), INVALID_BYTE_STR);
-#else
-            EXPECT_EQ(e.code(), API_NOT_ENABLED);
-#endif
+            EXPECT_EQ(e.code(), KEY_ALREADY_EXIST);
         }
 
-        if (NULL != amlObj)  delete amlObj;
+        vector<string> keys = info.getKeys();
+        vector<string> varify = {"axis", "b0", "id", "x", "zz"};
+        EXPECT_TRUE(isEqual(keys, varify));
+        EXPECT_EQ("f437da3b", info.getValueToStr("id"));
+        EXPECT_EQ("2", info.getValueToStr("b0"));
+        EXPECT_EQ("80", info.getValueToAMLData("axis").getValueToStr("z"));
+
+        AMLObject varifyObj = TestAMLObject();
+        EXPECT_TRUE(isEqual(*amlObj, varifyObj));
+
+        delete amlObj;
     }
 
-    TEST(DataToByteTest, ConvertValid)
+    TEST(AmlToDataTest, ConvertValidInArena)
     {
         Representation rep = Representation(amlModelFile);
-        AMLObject amlObj = TestAMLObject();
-        std::string amlBinary;
-#ifndef _DISABLE_PROTOBUF_
-        EXPECT_NO_THROW(amlBinary = rep.DataToByte(amlObj));
+        AMLArena arena;
+        std::string amlStr = TestAML();
+        AMLObject varify = TestAMLObject();
 
-        std::string varify = TestBinary();
-        EXPECT_EQ(varify.compare(amlBinary), 0);
-#else
-        try
+        // the same arena is reused after reset()
+        for (int i = 0; i < 3; i++)
         {
-            amlBinary = rep.DataToByte(amlObj);
-            FAIL();
-        }
-        catch (const AMLException& e)
-        {
-            EXPECT_EQ(e.code(), API_NOT_ENABLED);
+            AMLObject* amlObj = NULL;
+            EXPECT_NO_THROW(amlObj = rep.AmlToData(amlStr, arena));
+            ASSERT_TRUE(NULL != amlObj);
+            EXPECT_TRUE(isEqual(*amlObj, varify));
+
+            std::vector<char> buffer(amlStr.begin(), amlStr.end());
+            EXPECT_NO_THROW(amlObj = rep.AmlToData(buffer.data(), buffer.size(), arena));
+            ASSERT_TRUE(NULL != amlObj);
+            EXPECT_TRUE(isEqual(*amlObj, varify));
+
+            EXPECT_LT((size_t)0, arena.size());
+            arena.reset();
+            EXPECT_EQ((size_t)0, arena.size());
         }
-#endif
+    }
+
+    TEST(AmlToDataTest, CopyFromArena)
+    {
+        Representation rep = Representation(amlModelFile);
+        AMLArena arena;
+        AMLObject* amlObj = NULL;
+        EXPECT_NO_THROW(amlObj = rep.AmlToData(TestAML(), arena));
+        ASSERT_TRUE(NULL != amlObj);
+
+        AMLObject copyObj(*amlObj);
+        AMLData copyData = amlObj->getData("Sample");
+        arena.reset();
+
+        // copies are not in the arena, so they are valid after reset()
+        AMLObject varify = TestAMLObject();
+        EXPECT_TRUE(isEqual(copyObj, varify));
+        EXPECT_EQ("f437da3b", copyData.getValueToAMLData("info").getValueToStr("id"));
+        EXPECT_NO_THROW(copyData.setValue("x", "1"));
+        EXPECT_EQ("1", copyData.getValueToStr("x"));
+    }
+
+    TEST(AmlToDataTest, MoveFromArena)
+    {
+        Representation rep = Representation(amlModelFile);
+        std::string otherAml = rep.DataToAml(OtherAMLObject());
+        AMLArena arena;
+
+        vector<AMLObject> kept;
+        kept.push_back(std::move(*rep.AmlToData(TestAML(), arena)));
+
+        AMLObject emptyObj("deviceId", "timeStamp");
+        emptyObj = std::move(*rep.AmlToData(TestAML(), arena));
+
+        AMLObject mergedObj("deviceId", "timeStamp");
+        mergedObj.emplaceData("Extra").setValue("key", "value");
+        mergedObj = std::move(*rep.AmlToData(TestAML(), arena));
+
+        AMLData movedData;
+        AMLData mergedData;
+        mergedData.setValue("key", "value");
+        {
+            AMLObject arenaObj("deviceId", "timeStamp", "id", &arena);
+            AMLData& data1 = arenaObj.emplaceData("data1");
+            data1.setValue("x", "1");
+            movedData = AMLData(std::move(data1));
+
+            AMLData& data2 = arenaObj.emplaceData("data2");
+            data2.setValue("y", "2");
+            mergedData = std::move(data2);
+        }
+
+        // moved ones are not in the arena, so they are not changed by the next data decoded in the arena
+        arena.reset();
+        AMLObject* otherObj = rep.AmlToData(otherAml, arena);
+        AMLObject otherVarify = OtherAMLObject();
+        EXPECT_TRUE(isEqual(*otherObj, otherVarify));
+
+        AMLObject varify = TestAMLObject();
+        EXPECT_TRUE(isEqual(kept[0], varify));
+        EXPECT_TRUE(isEqual(emptyObj, varify));
+        EXPECT_EQ("value", mergedObj.getData("Extra").getValueToStr("key"));
+        EXPECT_EQ("Model_107.113.97.248", mergedObj.getData("Model").getValueToStr("a"));
+        EXPECT_EQ("f437da3b", mergedObj.getData("Sample").getValueToAMLData("info").getValueToStr("id"));
+        EXPECT_EQ("1", movedData.getValueToStr("x"));
+        EXPECT_EQ("value", mergedData.getValueToStr("key"));
+        EXPECT_EQ("2", mergedData.getValueToStr("y"));
+        arena.reset();
+    }
+
+    TEST(AmlToDataTest, InvalidAmlInArena)
+    {
+        Representation rep = Representation(amlModelFile);
+        AMLArena arena;
+        std::string invalidAmlStr("<invalid />");
+
+        try
+        {
+            rep.AmlToData(invalidAmlStr, arena);
+            FAIL();
+        }
+        catch (const AMLException& e)
+        {
+            EXPECT_EQ(e.code(), INVALID_AML_SCHEMA);
+        }
+        arena.reset();
+    }
+
+    TEST(AmlToDataTest, ConvertValidIntoObject)
+    {
+        Representation rep = Representation(amlModelFile);
+        std::string amlStr = TestAML();
+        AMLObject varify = TestAMLObject();
+
+        // the same AMLObject is overwritten by each conversion
+        AMLObject amlObj("device", "timestamp");
+        for (int i = 0; i < 3; i++)
+        {
+            EXPECT_NO_THROW(rep.AmlToData(amlStr, amlObj));
+            EXPECT_TRUE(isEqual(amlObj, varify));
+
+            std::vector<char> buffer(amlStr.begin(), amlStr.end());
+            EXPECT_NO_THROW(rep.AmlToData(buffer.data(), buffer.size(), amlObj));
+            EXPECT_TRUE(isEqual(amlObj, varify));
+        }
+
+        // other values replace the previous ones
+        AMLObject otherObj = OtherAMLObject();
+
+        EXPECT_NO_THROW(rep.AmlToData(rep.DataToAml(otherObj), amlObj));
+        EXPECT_TRUE(isEqual(amlObj, otherObj));
+
+        EXPECT_NO_THROW(rep.AmlToData(amlStr, amlObj));
+        EXPECT_TRUE(isEqual(amlObj, varify));
+    }
+
+    TEST(AmlToDataTest, ConvertIntoCopiedObject)
+    {
+        Representation rep = Representation(amlModelFile);
+        AMLObject amlObj("device", "timestamp");
+        EXPECT_NO_THROW(rep.AmlToData(TestAML(), amlObj));
+
+        // a copy keeps its values when the original is converted again
+        AMLObject copyObj(amlObj);
+        AMLObject otherObj = OtherAMLObject();
+
+        EXPECT_NO_THROW(rep.AmlToData(rep.DataToAml(otherObj), amlObj));
+        EXPECT_TRUE(isEqual(amlObj, otherObj));
+
+        AMLObject varify = TestAMLObject();
+        EXPECT_TRUE(isEqual(copyObj, varify));
+    }
+
+    TEST(AmlToDataTest, ConvertBatch)
+    {
+        Representation rep = Representation(amlModelFile);
+        vector<string> amlStrs{TestAML(), rep.DataToAml(OtherAMLObject()), TestAML()};
+        AMLObject varify = TestAMLObject();
+        AMLObject otherObj = OtherAMLObject();
+
+        vector<AMLObject> amlObjs;
+        EXPECT_NO_THROW(rep.AmlToData(amlStrs, amlObjs));
+        ASSERT_EQ((size_t)3, amlObjs.size());
+        EXPECT_TRUE(isEqual(amlObjs[0], varify));
+        EXPECT_TRUE(isEqual(amlObjs[1], otherObj));
+        EXPECT_TRUE(isEqual(amlObjs[2], varify));
+
+        // AMLObjects of the previous batch are reused, and the rest are removed
+        amlStrs.pop_back();
+        std::swap(amlStrs[0], amlStrs[1]);
+        EXPECT_NO_THROW(rep.AmlToData(amlStrs, amlObjs));
+        ASSERT_EQ((size_t)2, amlObjs.size());
+        EXPECT_TRUE(isEqual(amlObjs[0], otherObj));
+        EXPECT_TRUE(isEqual(amlObjs[1], varify));
+
+        // results before the failed string are kept
+        amlStrs[1] = "<invalid />";
+        try
+        {
+            rep.AmlToData(amlStrs, amlObjs);
+            FAIL();
+        }
+        catch (const AMLException& e)
+        {
+            EXPECT_EQ(e.code(), INVALID_AML_SCHEMA);
+        }
+        ASSERT_EQ((size_t)1, amlObjs.size());
+        EXPECT_TRUE(isEqual(amlObjs[0], otherObj));
+    }
+
+    TEST(AmlToDataTest, ConvertBatchInParallel)
+    {
+        Representation rep = Representation(amlModelFile);
+        AMLWorkerPool pool(4);
+        AMLObject varify = TestAMLObject();
+        AMLObject otherObj = OtherAMLObject();
+        std::string otherAml = rep.DataToAml(otherObj);
+
+        vector<string> amlStrs;
+        for (int i = 0; i < 100; i++)
+        {
+            amlStrs.push_back(0 == i % 3 ? otherAml : TestAML());
+        }
+
+        // AMLObjects are reused in the second batch
+        vector<AMLObject> amlObjs;
+        for (int n = 0; n < 2; n++)
+        {
+            EXPECT_NO_THROW(rep.AmlToData(amlStrs, amlObjs, pool));
+            ASSERT_EQ(amlStrs.size(), amlObjs.size());
+            for (size_t i = 0; i < amlObjs.size(); i++)
+            {
+                EXPECT_TRUE(isEqual(amlObjs[i], 0 == i % 3 ? otherObj : varify));
+            }
+        }
+
+        amlStrs[70] = "<invalid />";
+        amlStrs[37] = "<invalid />";
+        try
+        {
+            rep.AmlToData(amlStrs, amlObjs, pool);
+            FAIL();
+        }
+        catch (const AMLException& e)
+        {
+            EXPECT_EQ(e.code(), INVALID_AML_SCHEMA);
+        }
+        EXPECT_EQ((size_t)37, amlObjs.size());
+    }
+
+    TEST(AMLWorkerPoolTest, RunAllIndices)
+    {
+        AMLWorkerPool pool(4);
+        EXPECT_EQ((size_t)4, pool.threadCount());
+
+        vector<std::atomic<int>> counts(1000);
+        for (int n = 0; n < 3; n++)
+        {
+            pool.run(counts.size(), [&counts](size_t index) { counts[index]++; });
+        }
+        for (size_t i = 0; i < counts.size(); i++)
+        {
+            EXPECT_EQ(3, counts[i].load());
+        }
+
+        // exception of a task is rethrown, and the pool can run the next batch
+        EXPECT_THROW(pool.run(counts.size(), [](size_t index) { if (500 == index) throw std::runtime_error("task"); }),
+                     std::runtime_error);
+        std::atomic<size_t> sum(0);
+        pool.run(10, [&sum](size_t index) { sum += index; });
+        EXPECT_EQ((size_t)45, sum.load());
+
+        AMLWorkerPool defaultPool;
+        EXPECT_LE((size_t)1, defaultPool.threadCount());
+    }
+
+    TEST(DataToAmlTest, ConvertValid)
+    {
+        Representation rep = Representation(amlModelFile);
+        AMLObject amlObj = TestAMLObject();
+        std::string amlStr;
+        EXPECT_NO_THROW(amlStr = rep.DataToAml(amlObj));
+
+        std::string varify = TestAML();
+        EXPECT_EQ(varify.compare(amlStr), 0); //@TODO: issue - it does not return 0 though they are same string 
+    }
+
+    TEST(DataToAmlTest, ConvertValidToBuffer)
+    {
+        Representation rep = Representation(amlModelFile);
+        AMLObject amlObj = TestAMLObject();
+        std::string varify = TestAML();
+
+        // appended to the contents of the buffer
+        std::string amlStr("prefix");
+        EXPECT_NO_THROW(rep.DataToAml(amlObj, amlStr));
+        EXPECT_EQ("prefix" + varify, amlStr);
+
+        // the capacity of the buffer is kept for the next conversion
+        amlStr.clear();
+        size_t capacity = amlStr.capacity();
+        EXPECT_NO_THROW(rep.DataToAml(amlObj, amlStr));
+        EXPECT_EQ(varify, amlStr);
+        EXPECT_EQ(capacity, amlStr.capacity());
+
+        // the buffer is not changed by an invalid AMLObject
+        AMLObject notMatchToModel("deviceId", "0");
+        AMLData data;
+        data.setValue("invalidKey", "invalidValue");
+        notMatchToModel.addData("Model", data);
+        try
+        {
+            rep.DataToAml(notMatchToModel, amlStr);
+            FAIL();
+        }
+        catch (const AMLException& e)
+        {
+            EXPECT_EQ(e.code(), KEY_NOT_EXIST);
+        }
+        EXPECT_EQ(varify, amlStr);
+    }
+
+    TEST(DataToAmlTest, ConvertBatch)
+    {
+        Representation rep = Representation(amlModelFile);
+        vector<AMLObject> amlObjs{TestAMLObject(), OtherAMLObject(), TestAMLObject()};
+
+        // strings of the previous batch are replaced
+        vector<string> amlStrs(5, "previous");
+        EXPECT_NO_THROW(rep.DataToAml(amlObjs, amlStrs));
+        ASSERT_EQ(amlObjs.size(), amlStrs.size());
+        for (size_t i = 0; i < amlObjs.size(); i++)
+        {
+            EXPECT_EQ(rep.DataToAml(amlObjs[i]), amlStrs[i]);
+        }
+
+        // results before the failed AMLObject are kept
+        AMLObject notMatchToModel("deviceId", "0");
+        notMatchToModel.addData("invalidData", AMLData());
+        vector<AMLObject> invalidObjs{TestAMLObject(), notMatchToModel, TestAMLObject()};
+        try
+        {
+            rep.DataToAml(invalidObjs, amlStrs);
+            FAIL();
+        }
+        catch (const AMLException& e)
+        {
+            EXPECT_EQ(e.code(), NOT_MATCH_TO_AML_MODEL);
+        }
+        ASSERT_EQ((size_t)1, amlStrs.size());
+        EXPECT_EQ(TestAML(), amlStrs[0]);
+    }
+
+    TEST(DataToAmlTest, ConvertBatchInParallel)
+    {
+        Representation rep = Representation(amlModelFile);
+        AMLWorkerPool pool(4);
+        vector<AMLObject> amlObjs;
+        for (int i = 0; i < 100; i++)
+        {
+            amlObjs.push_back(0 == i % 3 ? OtherAMLObject() : TestAMLObject());
+        }
+
+        vector<string> amlStrs;
+        EXPECT_NO_THROW(rep.DataToAml(amlObjs, amlStrs, pool));
+        ASSERT_EQ(amlObjs.size(), amlStrs.size());
+        for (size_t i = 0; i < amlObjs.size(); i++)
+        {
+            EXPECT_EQ(rep.DataToAml(amlObjs[i]), amlStrs[i]);
+        }
+
+        // results before the first failed AMLObject are kept
+        AMLObject notMatchToModel("deviceId", "0");
+        notMatchToModel.addData("invalidData", AMLData());
+        vector<AMLObject> invalidObjs;
+        for (size_t i = 0; i < amlObjs.size(); i++)
+        {
+            invalidObjs.push_back(37 == i || 70 == i ? notMatchToModel : amlObjs[i]);
+        }
+        try
+        {
+            rep.DataToAml(invalidObjs, amlStrs, pool);
+            FAIL();
+        }
+        catch (const AMLException& e)
+        {
+            EXPECT_EQ(e.code(), NOT_MATCH_TO_AML_MODEL);
+        }
+        EXPECT_EQ((size_t)37, amlStrs.size());
+    }
+
+    TEST(DataToAmlTest, InvalidDataToModel)
+    {
+        Representation rep = Representation(amlModelFile);
+
+        AMLObject notMatchToModel("deviceId", "0");
+
+        AMLData data;
+        data.setValue("invalidKey", "invalidValue");
+
+        notMatchToModel.addData("invalidData", data);
+
+        try
+        {
+            rep.DataToAml(notMatchToModel);
+            FAIL();
+        }
+        catch (const AMLException& e)
+        {
+            EXPECT_EQ(e.code(), NOT_MATCH_TO_AML_MODEL);
+        }
+    }
+
+    TEST(DataToAmlTest, IgnoreDataNotInModel)
+    {
+        Representation rep = Representation(amlModelFile);
+        AMLObject amlObj = TestAMLObject();
+
+        AMLData sample = amlObj.getData("Sample");
+        sample.setValue("additionalKey", "additionalValue");
+
+        std::string amlStr;
+        EXPECT_NO_THROW(amlStr = rep.DataToAml(amlObj));
+
+        AMLObject *resultObj = NULL;
+        EXPECT_NO_THROW(resultObj = rep.AmlToData(amlStr));
+
+        AMLData sampleResult = resultObj->getData("Sample");
+
+        try
+        {
+            sampleResult.getValueToStr("additionalKey");
+            FAIL();
+        }
+        catch (const AMLException& e)
+        {
+            EXPECT_EQ(e.code(), KEY_NOT_EXIST);
+        }
+
+        if (NULL != resultObj) delete resultObj;
+    }
+
+    TEST(DataToAmlTest, EscapeSpecialCharacters)
+    {
+        Representation rep = Representation(amlModelFile);
+        AMLObject amlObj = TestAMLObject();
+
+        AMLData model;
+        model.setValue("a", "<a&b>\"c\"");
+        model.setValue("b", "SR-P7-970");
+
+        AMLObject escapeObj(amlObj.getDeviceId(), amlObj.getTimeStamp());
+        escapeObj.addData("Model", model);
+        escapeObj.addData("Sample", amlObj.getData("Sample"));
+
+        std::string amlStr;
+        EXPECT_NO_THROW(amlStr = rep.DataToAml(escapeObj));
+        EXPECT_NE(amlStr.find("<Value>&lt;a&amp;b&gt;\"c\"</Value>"), std::string::npos);
+
+        AMLObject *resultObj = NULL;
+        EXPECT_NO_THROW(resultObj = rep.AmlToData(amlStr));
+        EXPECT_TRUE(isEqual(*resultObj, escapeObj));
+
+        if (NULL != resultObj) delete resultObj;
+    }
+
+    TEST(ByteToDataTest, ConvertValid)
+    {
+        Representation rep = Representation(amlModelFile);
+        AMLObject* amlObj = NULL;
+        std::string binary = TestBinary();
+
+#ifndef _DISABLE_PROTOBUF_
+        EXPECT_NO_THROW(amlObj = rep.ByteToData(binary));
+
+        AMLObject varify = TestAMLObject();
+        EXPECT_TRUE(isEqual(*amlObj, varify));
+
+        if (NULL != amlObj)  delete amlObj;
+#else
+        try
+        {
+            amlObj = rep.ByteToData(binary);
+            FAIL();
+            (void)amlObj;
+        }
+        catch (const AMLException& e)
+        {
+            EXPECT_EQ(e.code(), API_NOT_ENABLED);
+        }
+#endif
+    }
+
+    TEST(ByteToDataTest, ConvertValidInArena)
+    {
+        Representation rep = Representation(amlModelFile);
+        AMLArena arena;
+        AMLObject* amlObj = NULL;
+        std::string binary = TestBinary();
+
+#ifndef _DISABLE_PROTOBUF_
+        EXPECT_NO_THROW(amlObj = rep.ByteToData(binary, arena));
+        ASSERT_TRUE(NULL != amlObj);
+
+        AMLObject varify = TestAMLObject();
+        EXPECT_TRUE(isEqual(*amlObj, varify));
+        arena.reset();
+#else
+        try
+        {
+            amlObj = rep.ByteToData(binary, arena);
+            FAIL();
+            (void)amlObj;
+        }
+        catch (const AMLException& e)
+        {
+            EXPECT_EQ(e.code(), API_NOT_ENABLED);
+        }
+#endif
+    }
+
+    TEST(ByteToDataTest, ConvertValidIntoObject)
+    {
+        Representation rep = Representation(amlModelFile);
+        AMLObject amlObj("device", "timestamp");
+        std::string binary = TestBinary();
+
+#ifndef _DISABLE_PROTOBUF_
+        AMLObject varify = TestAMLObject();
+        for (int i = 0; i < 3; i++)
+        {
+            EXPECT_NO_THROW(rep.ByteToData(binary, amlObj));
+            EXPECT_TRUE(isEqual(amlObj, varify));
+        }
+
+        AMLObject copyObj(amlObj);
+        AMLObject otherObj = OtherAMLObject();
+
+        EXPECT_NO_THROW(rep.ByteToData(rep.DataToByte(otherObj), amlObj));
+        EXPECT_TRUE(isEqual(amlObj, otherObj));
+        EXPECT_TRUE(isEqual(copyObj, varify));
+#else
+        try
+        {
+            rep.ByteToData(binary, amlObj);
+            FAIL();
+        }
+        catch (const AMLException& e)
+        {
+            EXPECT_EQ(e.code(), API_NOT_ENABLED);
+        }
+#endif
+    }
+
+    TEST(ByteToDataTest, ConvertBatch)
+    {
+        Representation rep = Representation(amlModelFile);
+        vector<AMLObject> amlObjs;
+        vector<string> binaries{TestBinary(), TestBinary()};
+
+#ifndef _DISABLE_PROTOBUF_
+        binaries[1] = rep.DataToByte(OtherAMLObject());
+        AMLObject varify = TestAMLObject();
+        AMLObject otherObj = OtherAMLObject();
+
+        for (int i = 0; i < 2; i++)
+        {
+            EXPECT_NO_THROW(rep.ByteToData(binaries, amlObjs));
+            ASSERT_EQ((size_t)2, amlObjs.size());
+            EXPECT_TRUE(isEqual(amlObjs[0], varify));
+            EXPECT_TRUE(isEqual(amlObjs[1], otherObj));
+        }
+
+        binaries[1] = "invalid";
+        try
+        {
+            rep.ByteToData(binaries, amlObjs);
+            FAIL();
+        }
+        catch (const AMLException& e)
+        {
+            EXPECT_EQ(e.code(), INVALID_BYTE_STR);
+        }
+        ASSERT_EQ((size_t)1, amlObjs.size());
+        EXPECT_TRUE(isEqual(amlObjs[0], varify));
+#else
+        try
+        {
+            rep.ByteToData(binaries, amlObjs);
+            FAIL();
+        }
+        catch (const AMLException& e)
+        {
+            EXPECT_EQ(e.code(), API_NOT_ENABLED);
+        }
+#endif
+    }
+
+    TEST(ByteToDataTest, ConvertBatchInParallel)
+    {
+        Representation rep = Representation(amlModelFile);
+        AMLWorkerPool pool(4);
+        vector<AMLObject> amlObjs;
+        for (int i = 0; i < 100; i++)
+        {
+            amlObjs.push_back(0 == i % 3 ? OtherAMLObject() : TestAMLObject());
+        }
+        vector<string> binaries;
+        vector<AMLObject> decoded;
+
+#ifndef _DISABLE_PROTOBUF_
+        EXPECT_NO_THROW(rep.DataToByte(amlObjs, binaries, pool));
+        ASSERT_EQ(amlObjs.size(), binaries.size());
+        EXPECT_EQ(TestBinary(), binaries[1]);
+
+        EXPECT_NO_THROW(rep.ByteToData(binaries, decoded, pool));
+        ASSERT_EQ(amlObjs.size(), decoded.size());
+        for (size_t i = 0; i < amlObjs.size(); i++)
+        {
+            EXPECT_TRUE(isEqual(decoded[i], amlObjs[i]));
+        }
+
+        binaries[37] = "invalid";
+        try
+        {
+            rep.ByteToData(binaries, decoded, pool);
+            FAIL();
+        }
+        catch (const AMLException& e)
+        {
+            EXPECT_EQ(e.code(), INVALID_BYTE_STR);
+        }
+        EXPECT_EQ((size_t)37, decoded.size());
+#else
+        try
+        {
+            rep.ByteToData(binaries, decoded, pool);
+            FAIL();
+        }
+        catch (const AMLException& e)
+        {
+            EXPECT_EQ(e.code(), API_NOT_ENABLED);
+        }
+#endif
+    }
+
+    TEST(ByteToDataTest, InvalidByte)
+    {
+        Representation rep = Representation(amlModelFile);
+        AMLObject* amlObj = NULL;
+        std::string amlBinary("invalidBinary");
+
+        try
+        {
+            amlObj = rep.ByteToData(amlBinary);
+            FAIL();
+        }
+        catch (const AMLException& e)
+        {
+#ifndef _DISABLE_PROTOBUF_
+            EXPECT_EQ(e.code(), INVALID_BYTE_STR);
+#else
+            EXPECT_EQ(e.code(), API_NOT_ENABLED);
+#endif
+        }
+
+        if (NULL != amlObj)  delete amlObj;
+    }
+
+    TEST(DataToByteTest, ConvertValid)
+    {
+        Representation rep = Representation(amlModelFile);
+        AMLObject amlObj = TestAMLObject();
+        std::string amlBinary;
+#ifndef _DISABLE_PROTOBUF_
+        EXPECT_NO_THROW(amlBinary = rep.DataToByte(amlObj));
+
+        std::string varify = TestBinary();
+        EXPECT_EQ(varify.compare(amlBinary), 0);
+#else
+        try
+        {
+            amlBinary = rep.DataToByte(amlObj);
+            FAIL();
+        }
+        catch (const AMLException& e)
+        {
+            EXPECT_EQ(e.code(), API_NOT_ENABLED);
+        }
+#endif
+    }
+
+    TEST(DataToByteTest, ConvertValidToBuffer)
+    {
+        Representation rep = Representation(amlModelFile);
+        AMLObject amlObj = TestAMLObject();
+        std::string amlBinary("prefix");
+#ifndef _DISABLE_PROTOBUF_
+        std::string varify = TestBinary();
+        EXPECT_NO_THROW(rep.DataToByte(amlObj, amlBinary));
+        EXPECT_EQ("prefix" + varify, amlBinary);
+
+        amlBinary.clear();
+        size_t capacity = amlBinary.capacity();
+        EXPECT_NO_THROW(rep.DataToByte(amlObj, amlBinary));
+        EXPECT_EQ(varify, amlBinary);
+        EXPECT_EQ(capacity, amlBinary.capacity());
+#else
+        try
+        {
+            rep.DataToByte(amlObj, amlBinary);
+            FAIL();
+        }
+        catch (const AMLException& e)
+        {
+            EXPECT_EQ(e.code(), API_NOT_ENABLED);
+        }
+#endif
+    }
+
+    TEST(DataToByteTest, ConvertBatch)
+    {
+        Representation rep = Representation(amlModelFile);
+        vector<AMLObject> amlObjs{TestAMLObject(), OtherAMLObject()};
+        vector<string> binaries;
+#ifndef _DISABLE_PROTOBUF_
+        EXPECT_NO_THROW(rep.DataToByte(amlObjs, binaries));
+        ASSERT_EQ((size_t)2, binaries.size());
+        EXPECT_EQ(TestBinary(), binaries[0]);
+        EXPECT_EQ(rep.DataToByte(amlObjs[1]), binaries[1]);
+#else
+        try
+        {
+            rep.DataToByte(amlObjs, binaries);
+            FAIL();
+        }
+        catch (const AMLException& e)
+        {
+            EXPECT_EQ(e.code(), API_NOT_ENABLED);
+        }
+#endif
+    }
+
+    TEST(GeneratedModelTest, ConvertEvents)
+    {
+        AMLGenerator generator(GeneratedModelConfig());
+        generator.writeModel(generatedModelFile);
+        Representation rep = Representation(generatedModelFile);
+
+        vector<AMLObject> amlObjs;
+        generator.events(10, amlObjs);
+
+        for (AMLObject& amlObj : amlObjs)
+        {
+            ASSERT_EQ(generator.dataNames(), amlObj.getDataNames());
+
+            AMLObject* xmlObj = rep.AmlToData(rep.DataToAml(amlObj));
+            EXPECT_TRUE(isEqual(*xmlObj, amlObj));
+            delete xmlObj;
+
+#ifndef _DISABLE_PROTOBUF_
+            AMLObject* byteObj = rep.ByteToData(rep.DataToByte(amlObj));
+            EXPECT_TRUE(isEqual(*byteObj, amlObj));
+            delete byteObj;
+#endif
+        }
+    }
+
+    TEST(GeneratedModelTest, ConvertLargeEvent)
+    {
+        // 16000 signals, whose message is released by the converting thread after each conversion
+        AMLGeneratorConfig config = GeneratedModelConfig();
+        config.attributeCount = 4000;
+        AMLGenerator generator(config);
+        generator.writeModel(generatedModelFile);
+        Representation largeRep = Representation(generatedModelFile);
+        Representation rep = Representation(amlModelFile);
+        AMLObject largeObj = generator.event();
+        AMLObject amlObj = TestAMLObject();
+
+#ifndef _DISABLE_PROTOBUF_
+        for (int i = 0; i < 2; i++)
+        {
+            AMLObject* byteObj = largeRep.ByteToData(largeRep.DataToByte(largeObj));
+            EXPECT_TRUE(isEqual(*byteObj, largeObj));
+            delete byteObj;
+
+            EXPECT_EQ(TestBinary(), rep.DataToByte(amlObj));
+            byteObj = rep.ByteToData(TestBinary());
+            EXPECT_TRUE(isEqual(*byteObj, amlObj));
+            delete byteObj;
+        }
+#else
+        EXPECT_THROW(largeRep.DataToByte(largeObj), AMLException);
+#endif
+    }
+
+    TEST(GeneratedModelTest, GetConfigInfo)
+    {
+        AMLGenerator generator(GeneratedModelConfig());
+        generator.writeModel(generatedModelFile);
+        Representation rep = Representation(generatedModelFile);
+
+        AMLObject* config = rep.getConfigInfo();
+        EXPECT_EQ(generator.config().deviceId, config->getDeviceId());
+        EXPECT_EQ(generator.dataNames(), config->getDataNames());
+        EXPECT_EQ("10", config->getData("Unit0").getValueToStr("c0"));
+        delete config;
+    }
+
+    TEST(GeneratedModelTest, SameEventsForSeed)
+    {
+        AMLGenerator generator1(GeneratedModelConfig());
+        AMLGenerator generator2(GeneratedModelConfig());
+        EXPECT_EQ(generator1.model(), generator2.model());
+
+        AMLObject amlObj1 = generator1.event();
+        AMLObject amlObj2 = generator2.event();
+        EXPECT_TRUE(isEqual(amlObj1, amlObj2));
+
+        AMLObject nextObj = generator1.event();
+        EXPECT_NE(amlObj1.getTimeStamp(), nextObj.getTimeStamp());
+        EXPECT_FALSE(isEqual(amlObj1, nextObj));
+    }
+
+    TEST(GeneratedModelTest, InvalidConfig)
+    {
+        AMLGeneratorConfig config;
+        config.nestedAttributeCount = 1;
+        config.nestingDepth = 0;
+        EXPECT_THROW(AMLGenerator generator(config), AMLException);
     }
 
     TEST(GetRepresentationIdTest, GetValid)